@@ -0,0 +1,94 @@
+/*************************************************************************************[BenchUtils.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_BenchUtils_h
+#define Minisat_BenchUtils_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Helpers shared by the benchmark driver and the tuner:
+
+
+static inline char* copyString(const char* str, int len)
+{
+    char* copy = (char*)malloc(len + 1);
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+
+// Reads a list of instances (as 'tests/inputs/easy.txt'), one name per line; empty lines are skipped:
+static inline bool readList(const char* file, vec<char*>& names)
+{
+    FILE* in = NULL;
+    fopen_s(&in, file, "rb");
+    if (in == NULL)
+        return false;
+
+    char line[4096];
+    while (fgets(line, sizeof(line), in) != NULL){
+        int n = (int)strlen(line);
+        while (n > 0 && (line[n-1] == '\n' || line[n-1] == '\r' || line[n-1] == ' '))
+            line[--n] = '\0';
+        if (n > 0)
+            names.push(copyString(line, n));
+    }
+    fclose(in);
+    return true;
+}
+
+
+// Interrupts the solver if a run takes more than 'timeout' seconds of wall-clock time (no limit if
+// 'timeout' is not positive):
+class Watchdog {
+    std::mutex              mtx;
+    std::condition_variable cv;
+    bool                    done;
+    std::thread             thread;
+
+public:
+    Watchdog(Solver& S, double timeout) : done(false) {
+        if (timeout > 0)
+            thread = std::thread([this, &S, timeout]{
+                std::unique_lock<std::mutex> lock(mtx);
+                if (!cv.wait_for(lock, std::chrono::duration<double>(timeout), [this]{ return done; }))
+                    S.interrupt(); }); }
+
+    ~Watchdog() {
+        { std::lock_guard<std::mutex> lock(mtx); done = true; }
+        cv.notify_one();
+        if (thread.joinable()) thread.join(); }
+};
+
+//=================================================================================================
+}
+
+#endif
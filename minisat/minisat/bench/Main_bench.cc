@@ -0,0 +1,301 @@
+/**********************************************************************************[Main_bench.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "minisat/utils/System.h"
+#include "minisat/utils/ParseUtils.h"
+#include "minisat/utils/Options.h"
+#include "minisat/mtl/Sort.h"
+#include "minisat/core/Dimacs.h"
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "minisat/bench/BenchUtils.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Benchmark driver -- solves every instance of one or more lists (as 'tests/inputs/easy.txt') a
+// number of times in this process, and reports the median over the runs of:
+//
+//   wall, cpu    -- seconds spent in 'simplify()' and 'solveLimited()' (parsing is not included),
+//   conflicts, propagations per CPU second,
+//   mem          -- peak memory of the process when the solve ends, in MB; a high-water mark of
+//                   the whole process, so it includes the instances solved before (run one list
+//                   per process, small instances first, to see the peak of each).
+//
+// With '-simp' the instances are preprocessed by 'SimpSolver::eliminate()' first (its options, as
+// '-elim-threads', apply), and the wall time of the preprocessing and the number of clauses left
+// are reported as well.
+//
+// The results can be written as JSON ('-out') and compared with an earlier result file ('-baseline'):
+// an instance whose median wall time grew by more than '-threshold' percent (and by more than
+// '-min-time' seconds, to ignore noise on tiny instances) is a regression. Wrong answers (the
+// expected answer is the top directory, 'SAT' or 'UNSAT') and regressions make the exit code 1.
+
+//MM: modifications to original minisat source code
+namespace bench {
+
+struct Result {
+    char*    name;
+    lbool    status;
+    bool     ok;
+    double   wall, wall_min, cpu, mem;
+    double   simp;      // Wall time of the preprocessing ('-simp').
+    int      clauses;   // Clauses left by the preprocessing ('-simp').
+    uint64_t conflicts, propagations;
+};
+
+struct Baseline {
+    char*    name;
+    double   wall;
+};
+
+
+static void pinToCpu(int cpu)
+{
+#if defined(_WIN32)
+    if (SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) == 0)
+        fprintf(stderr, "WARNING! Could not pin the benchmark to CPU %d.\n", cpu);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        fprintf(stderr, "WARNING! Could not pin the benchmark to CPU %d.\n", cpu);
+#else
+    fprintf(stderr, "WARNING! Pinning to CPU %d is not supported on this platform.\n", cpu);
+#endif
+}
+
+
+static double median(vec<double>& xs)
+{
+    sort(xs);
+    int n = xs.size();
+    return n == 0 ? 0 : n % 2 == 1 ? xs[n/2] : (xs[n/2-1] + xs[n/2]) / 2;
+}
+
+
+// Reads a file written by 'writeResults()'; every instance is on a line of its own:
+static bool readBaseline(const char* file, vec<Baseline>& base)
+{
+    FILE* in = NULL;
+    fopen_s(&in, file, "rb");
+    if (in == NULL)
+        return false;
+
+    char line[8192];
+    while (fgets(line, sizeof(line), in) != NULL){
+        char* name = strstr(line, "\"name\": \"");
+        char* wall = strstr(line, "\"wall\": ");
+        if (name == NULL || wall == NULL)
+            continue;
+        name += strlen("\"name\": \"");
+        char* end = strchr(name, '"');
+        if (end == NULL)
+            continue;
+
+        Baseline b;
+        b.name = copyString(name, (int)(end - name));
+        b.wall = strtod(wall + strlen("\"wall\": "), NULL);
+        base.push(b);
+    }
+    fclose(in);
+    return true;
+}
+
+
+static const char* statusName(lbool status) { return status == l_True ? "SAT" : status == l_False ? "UNSAT" : "TIMEOUT"; }
+
+
+static void writeResults(FILE* out, const vec<Result>& results, int runs)
+{
+    fprintf(out, "{\"runs\": %d, \"instances\": [\n", runs);
+    for (int i = 0; i < results.size(); i++){
+        const Result& r = results[i];
+        fprintf(out, "  {\"name\": \"%s\", \"status\": \"%s\", \"ok\": %s, \"wall\": %.6f, \"wall_min\": %.6f, \"cpu\": %.6f, "
+                "\"conflicts\": %" PRIu64 ", \"propagations\": %" PRIu64 ", \"conflicts_per_sec\": %.0f, \"propagations_per_sec\": %.0f, \"mem\": %.2f, "
+                "\"simp\": %.6f, \"clauses\": %d}%s\n",
+                r.name, statusName(r.status), r.ok ? "true" : "false", r.wall, r.wall_min, r.cpu,
+                r.conflicts, r.propagations, r.cpu > 0 ? r.conflicts / r.cpu : 0, r.cpu > 0 ? r.propagations / r.cpu : 0, r.mem,
+                r.simp, r.clauses, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "]}\n");
+}
+
+
+static bool runInstance(const char* dir, const char* name, int runs, double timeout, bool simp, Result& r)
+{
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+    vec<double> walls, cpus, simps;
+    r.name    = copyString(name, (int)strlen(name));
+    r.status  = l_Undef;
+    r.mem     = 0;
+    r.clauses = 0;
+    for (int run = 0; run < runs; run++){
+        SimpSolver* SS = simp ? new SimpSolver() : NULL;
+        Solver*     S  = simp ? SS : new Solver();
+        S->verbosity = 0;
+
+        FILE* in = NULL;
+        fopen_s(&in, path, "rb");
+        if (in == NULL){
+            delete S;
+            return false; }
+        if (simp) parse_DIMACS(in, *SS);
+        else      parse_DIMACS(in, *S);
+        fclose(in);
+
+        double wall0 = realTime(), cpu0 = cpuTime();
+        lbool  ret;
+        {
+            Watchdog watchdog(*S, timeout);
+            vec<Lit> dummy;
+            if (simp){
+                bool ok = SS->eliminate(true);
+                simps.push(realTime() - wall0);
+                r.clauses = SS->nClauses();
+                ret = !ok ? l_False : SS->solveLimited(dummy);
+            }else
+                ret = !S->simplify() ? l_False : S->solveLimited(dummy);
+        }
+        walls.push(realTime() - wall0);
+        cpus.push(cpuTime() - cpu0);
+
+        double mem = memUsedPeak();
+        if (mem > r.mem) r.mem = mem;
+        r.status       = ret;
+        r.conflicts    = S->conflicts;
+        r.propagations = S->propagations;
+        delete S;
+    }
+
+    r.wall     = median(walls);
+    r.wall_min = walls[0];   // (sorted by 'median()')
+    r.cpu      = median(cpus);
+    r.simp     = median(simps);
+
+    bool expect_sat = strncmp(name, "SAT/", 4) == 0;
+    r.ok = r.status == l_Undef || (r.status == l_True) == expect_sat;
+    return true;
+}
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    try {
+        setUsageHelp("USAGE: %s [options]\n\n  Solves the instances of the given lists and compares the times with a baseline.\n");
+
+        StringOption dir      ("MAIN", "inputs",   "Directory of the instances (the names in the lists are relative to it).", "tests/inputs");
+        StringOption lists    ("MAIN", "lists",    "Comma separated lists of instances (relative to '-inputs').", "easy.txt,benchmarks.txt");
+        IntOption    runs     ("MAIN", "runs",     "Number of runs of each instance.", 3, IntRange(1, INT32_MAX));
+        DoubleOption timeout  ("MAIN", "timeout",  "Wall-clock seconds before a run is stopped (0 = no limit).", 600, DoubleRange(0, true, HUGE_VAL, false));
+        IntOption    pin      ("MAIN", "pin",      "Pin the benchmark to this CPU (-1 = do not pin).", 0, IntRange(-1, 1023));
+        StringOption out_name ("MAIN", "out",      "If given, write the results as JSON to this file.");
+        StringOption base_name("MAIN", "baseline", "If given, compare with the results in this file (as written by '-out').");
+        DoubleOption threshold("MAIN", "threshold","Slow-down in percent of the median wall time that counts as a regression.", 10, DoubleRange(0, true, HUGE_VAL, false));
+        DoubleOption min_time ("MAIN", "min-time", "Slow-downs of less than this many seconds are ignored.", 0.05, DoubleRange(0, true, HUGE_VAL, false));
+        BoolOption   simp     ("MAIN", "simp",     "Preprocess with variable elimination, and report its time and the clauses left.", false);
+
+        parseOptions(argc, argv, true);
+
+        if (pin >= 0)
+            pinToCpu(pin);
+
+        // Collect the instances:
+        vec<char*> names;
+        for (const char* list = lists; *list != '\0';){
+            const char* end = strchr(list, ',');
+            int         len = end == NULL ? (int)strlen(list) : (int)(end - list);
+            char        path[4096];
+            snprintf(path, sizeof(path), "%s/%.*s", (const char*)dir, len, list);
+            if (len > 0 && !readList(path, names))
+                fprintf(stderr, "ERROR! Could not open file: %s\n", path), exit(1);
+            list += len + (end != NULL);
+        }
+
+        vec<Baseline> base;
+        if (base_name != NULL && !readBaseline(base_name, base))
+            fprintf(stderr, "ERROR! Could not open file: %s\n", (const char*)base_name), exit(1);
+
+        printf("%-45s %-8s %10s %10s %12s %12s %8s", "instance", "status", "wall (s)", "cpu (s)", "confl/s", "props/s", "mem (MB)");
+        if (simp) printf(" %10s %10s", "simp (s)", "clauses");
+        printf(" %10s %8s\n", "base (s)", "change");
+
+        vec<Result> results;
+        int         wrong = 0, regressions = 0;
+        for (int i = 0; i < names.size(); i++){
+            Result r;
+            if (!runInstance(dir, names[i], runs, timeout, simp, r))
+                fprintf(stderr, "ERROR! Could not open file: %s/%s\n", (const char*)dir, names[i]), exit(1);
+            results.push(r);
+
+            printf("%-45s %-8s %10.4f %10.4f %12.0f %12.0f %8.1f", r.name, r.ok ? statusName(r.status) : "WRONG",
+                   r.wall, r.cpu, r.cpu > 0 ? r.conflicts / r.cpu : 0, r.cpu > 0 ? r.propagations / r.cpu : 0, r.mem);
+            if (simp) printf(" %10.4f %10d", r.simp, r.clauses);
+            wrong += !r.ok;
+
+            int b;
+            for (b = 0; b < base.size() && strcmp(base[b].name, r.name) != 0; b++);
+            if (b < base.size()){
+                double change     = base[b].wall > 0 ? (r.wall - base[b].wall) * 100 / base[b].wall : 0;
+                bool   regression = change > threshold && r.wall - base[b].wall > min_time;
+                printf(" %10.4f %+7.1f%%%s", base[b].wall, change, regression ? "  REGRESSION" : "");
+                regressions += regression;
+            }
+            printf("\n");
+            fflush(stdout);
+        }
+
+        if (out_name != NULL){
+            FILE* out = NULL;
+            fopen_s(&out, out_name, "wb");
+            if (out == NULL)
+                fprintf(stderr, "ERROR! Could not open file: %s\n", (const char*)out_name), exit(1);
+            writeResults(out, results, runs);
+            fclose(out);
+        }
+
+        printf("%d instances, %d wrong, %d regressions\n", results.size(), wrong, regressions);
+        exit(wrong > 0 || regressions > 0 ? 1 : 0);
+    } catch (OutOfMemoryException&){
+        fprintf(stderr, "===============================================================================\n");
+        fprintf(stderr, "INDETERMINATE\n");
+        exit(0);
+    }
+}
+
+//MM: modifications to original minisat source code
+} //namespace bench
@@ -0,0 +1,324 @@
+/*********************************************************************************[Main_ipasir.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "minisat/utils/Options.h"
+#include "minisat/mtl/Sort.h"
+#include "minisat/core/Solver.h"
+#include "minisat/ipasir/ipasir.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Overhead of the IPASIR interface over the native API of 'Solver', for fine-grained incremental
+// use. The same inputs (generated before the clock starts) go through both:
+//
+//   add    -- adding random 3-clauses (one 'addClause()' against four 'ipasir_add()' per clause),
+//   solve  -- many queries over a small satisfiable random 3-SAT formula: assume a few literals,
+//             solve, and read the value (or the failure) of every assumed literal,
+//   val    -- reading the value of every variable after a single call to the solver.
+//
+// Times are per clause, query and value respectively. The library behind 'ipasir.h' is built on
+// 'Solver' unless it was configured with MINISAT_IPASIR_SIMP; only then do both sides differ in
+// more than the interface.
+
+//MM: modifications to original minisat source code
+namespace ipasirbench {
+
+struct Sizes {
+    int vars;
+    int clauses;
+    int queries;
+    int assumps;   // Assumptions of each query.
+};
+
+
+static volatile uint64_t sink;   // Results are added here, so the compiler cannot drop the work.
+
+
+class Random {
+    uint64_t state;
+public:
+    Random(uint64_t seed) : state(seed * 2685821657736338717ULL + 1) {}
+    uint32_t next () { state ^= state >> 12; state ^= state << 25; state ^= state >> 27; return (uint32_t)((state * 2685821657736338717ULL) >> 32); }
+    int      range(int lo, int hi) { return lo + (int)(next() % (uint32_t)(hi - lo)); }   // In [lo, hi).
+};
+
+
+class Timer {
+    std::chrono::steady_clock::time_point start;
+public:
+    Timer() : start(std::chrono::steady_clock::now()) {}
+    double seconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+};
+
+
+// The same literals in both forms: DIMACS integers and 'Lit's.
+struct Input {
+    vec<int> dimacs;     // 0-terminated clauses.
+    vec<Lit> lits;       // 'lit_Undef'-terminated clauses.
+    vec<int> queries;    // 'Sizes::assumps' literals per query.
+};
+
+static Lit toLit(int l) { return mkLit(abs(l) - 1, l < 0); }
+
+// Clauses have three distinct variables, in the ratio of 3 clauses per variable (almost always
+// satisfiable, and easy):
+static void randomInput(Random& rnd, const Sizes& sz, Input& in)
+{
+    for (int i = 0; i < sz.clauses; i++){
+        int a = rnd.range(1, sz.vars + 1), b, c;
+        do b = rnd.range(1, sz.vars + 1); while (b == a);
+        do c = rnd.range(1, sz.vars + 1); while (c == a || c == b);
+        int cl[3] = { a, b, c };
+        for (int j = 0; j < 3; j++){
+            int l = rnd.next() & 1 ? -cl[j] : cl[j];
+            in.dimacs.push(l);
+            in.lits.push(toLit(l)); }
+        in.dimacs.push(0);
+        in.lits.push(lit_Undef);
+    }
+    for (int i = 0; i < sz.queries * sz.assumps; i++){
+        int v = rnd.range(1, sz.vars + 1);
+        in.queries.push(rnd.next() & 1 ? -v : v); }
+}
+
+
+//=================================================================================================
+// Native API:
+
+
+static void nativeAdd(Solver& S, const Sizes& sz, const Input& in)
+{
+    while (S.nVars() < sz.vars) S.newVar();
+    vec<Lit> ps;
+    for (int i = 0; i < in.lits.size(); i++)
+        if (in.lits[i] == lit_Undef){
+            S.addClause_(ps);
+            ps.clear();
+        }else
+            ps.push(in.lits[i]);
+}
+
+static uint64_t nativeAddBench(const Sizes& sz, const Input& in, double& secs)
+{
+    Solver S;
+    Timer  t;
+    nativeAdd(S, sz, in);
+    secs = t.seconds();
+    sink += S.nClauses();
+    return sz.clauses;
+}
+
+static uint64_t nativeSolveBench(const Sizes& sz, const Input& in, double& secs)
+{
+    Solver   S;
+    nativeAdd(S, sz, in);
+    vec<Lit> assumps;
+    uint64_t sat = 0, marks = 0;
+    Timer    t;
+    for (int q = 0; q < sz.queries; q++){
+        assumps.clear();
+        for (int i = 0; i < sz.assumps; i++)
+            assumps.push(toLit(in.queries[q * sz.assumps + i]));
+        if (S.solve(assumps)){
+            sat++;
+            for (int i = 0; i < assumps.size(); i++)
+                marks += S.modelValue(assumps[i]) == l_True;
+        }else
+            for (int i = 0; i < assumps.size(); i++)
+                for (int j = 0; j < S.conflict.size(); j++)
+                    marks += S.conflict[j] == ~assumps[i];
+    }
+    secs = t.seconds();
+    sink += sat + marks;
+    return sz.queries;
+}
+
+static uint64_t nativeValBench(const Sizes& sz, const Input& in, double& secs)
+{
+    Solver   S;
+    nativeAdd(S, sz, in);
+    S.solve();
+    uint64_t trues  = 0;
+    int      rounds = 10;
+    Timer    t;
+    for (int r = 0; r < rounds; r++)
+        for (Var v = 0; v < sz.vars; v++)
+            trues += S.modelValue(v) == l_True;
+    secs = t.seconds();
+    sink += trues;
+    return (uint64_t)rounds * sz.vars;
+}
+
+
+//=================================================================================================
+// IPASIR:
+
+
+static void ipasirAdd(void* s, const Input& in)
+{
+    for (int i = 0; i < in.dimacs.size(); i++)
+        ipasir_add(s, in.dimacs[i]);
+}
+
+static uint64_t ipasirAddBench(const Sizes& sz, const Input& in, double& secs)
+{
+    void* s = ipasir_init();
+    Timer t;
+    ipasirAdd(s, in);
+    secs = t.seconds();
+    ipasir_release(s);
+    return sz.clauses;
+}
+
+static uint64_t ipasirSolveBench(const Sizes& sz, const Input& in, double& secs)
+{
+    void*    s = ipasir_init();
+    ipasirAdd(s, in);
+    uint64_t sat = 0, marks = 0;
+    Timer    t;
+    for (int q = 0; q < sz.queries; q++){
+        const int* as = &in.queries[q * sz.assumps];
+        for (int i = 0; i < sz.assumps; i++)
+            ipasir_assume(s, as[i]);
+        if (ipasir_solve(s) == 10){
+            sat++;
+            for (int i = 0; i < sz.assumps; i++)
+                marks += ipasir_val(s, as[i]) == as[i];
+        }else
+            for (int i = 0; i < sz.assumps; i++)
+                marks += ipasir_failed(s, as[i]);
+    }
+    secs = t.seconds();
+    sink += sat + marks;
+    ipasir_release(s);
+    return sz.queries;
+}
+
+static uint64_t ipasirValBench(const Sizes& sz, const Input& in, double& secs)
+{
+    void*    s = ipasir_init();
+    ipasirAdd(s, in);
+    ipasir_solve(s);
+    uint64_t trues  = 0;
+    int      rounds = 10;
+    Timer    t;
+    for (int r = 0; r < rounds; r++)
+        for (int v = 1; v <= sz.vars; v++)
+            trues += ipasir_val(s, v) > 0;
+    secs = t.seconds();
+    sink += trues;
+    ipasir_release(s);
+    return (uint64_t)rounds * sz.vars;
+}
+
+
+typedef uint64_t (*Benchmark)(const Sizes& sz, const Input& in, double& secs);
+
+static const struct {
+    const char* name;
+    Benchmark   native;
+    Benchmark   ipasir;
+    bool        small;    // Runs on the small formula (every query is a search over all its variables).
+} benchmarks[] = {
+    { "add",   nativeAddBench,   ipasirAddBench,   false },
+    { "solve", nativeSolveBench, ipasirSolveBench, true  },
+    { "val",   nativeValBench,   ipasirValBench,   false },
+};
+
+
+static double median(vec<double>& xs)
+{
+    sort(xs);
+    int n = xs.size();
+    return n == 0 ? 0 : n % 2 == 1 ? xs[n/2] : (xs[n/2-1] + xs[n/2]) / 2;
+}
+
+static double timeBench(Benchmark b, const Sizes& sz, const Input& in, int reps, uint64_t& ops)
+{
+    vec<double> times;
+    for (int r = 0; r < reps; r++){
+        double secs = 0;
+        ops = b(sz, in, secs);
+        times.push(secs);
+    }
+    return median(times);
+}
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    try {
+        setUsageHelp("USAGE: %s [options]\n\n  Compares the IPASIR interface with the native API of the solver.\n");
+
+        IntOption    reps   ("MAIN", "reps",    "Number of repetitions of each benchmark.", 5, IntRange(1, INT32_MAX));
+        DoubleOption scale  ("MAIN", "scale",   "Scale of the default sizes (20k variables, or 300 for the queries, and 20k queries).", 1, DoubleRange(0, false, 100, true));
+        IntOption    assumps("MAIN", "assumps", "Number of assumptions of each query.", 3, IntRange(1, INT32_MAX));
+        StringOption filter ("MAIN", "filter",  "Only run the benchmarks whose name contains this string.");
+        IntOption    seed   ("MAIN", "seed",    "Seed of the random inputs.", 1, IntRange(0, INT32_MAX));
+
+        parseOptions(argc, argv, true);
+
+        Sizes large, small;
+        large.vars    = (int)(20000 * scale) + 3;
+        small.vars    = (int)(  300 * scale) + 3;
+        large.clauses = 3 * large.vars;
+        small.clauses = 3 * small.vars;
+        large.queries = small.queries = (int)(20000 * scale) + 1;
+        large.assumps = small.assumps = assumps;
+
+        Random rnd(seed);
+        Input  large_in, small_in;
+        randomInput(rnd, large, large_in);
+        randomInput(rnd, small, small_in);
+
+        printf("IPASIR: %s\n", ipasir_signature());
+        printf("%-10s %12s %16s %16s %12s %12s %10s\n", "benchmark", "ops", "native (ms)", "ipasir (ms)", "native ns/op", "ipasir ns/op", "overhead");
+        for (int b = 0; b < (int)(sizeof(benchmarks) / sizeof(benchmarks[0])); b++){
+            if (filter != NULL && strstr(benchmarks[b].name, filter) == NULL)
+                continue;
+
+            const Sizes& sz  = benchmarks[b].small ? small    : large;
+            const Input& in  = benchmarks[b].small ? small_in : large_in;
+            uint64_t     ops = 0;
+            double       nat = timeBench(benchmarks[b].native, sz, in, reps, ops);
+            double       ipa = timeBench(benchmarks[b].ipasir, sz, in, reps, ops);
+            printf("%-10s %12" PRIu64 " %16.3f %16.3f %12.2f %12.2f %9.1f%%\n",
+                   benchmarks[b].name, ops, nat * 1000, ipa * 1000,
+                   ops > 0 ? nat * 1e9 / ops : 0, ops > 0 ? ipa * 1e9 / ops : 0,
+                   nat > 0 ? (ipa / nat - 1) * 100 : 0);
+            fflush(stdout);
+        }
+        exit(0);
+    } catch (OutOfMemoryException&){
+        fprintf(stderr, "===============================================================================\n");
+        fprintf(stderr, "INDETERMINATE\n");
+        exit(0);
+    }
+}
+
+//MM: modifications to original minisat source code
+} //namespace ipasirbench
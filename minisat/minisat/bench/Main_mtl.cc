@@ -0,0 +1,474 @@
+/************************************************************************************[Main_mtl.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "minisat/utils/Options.h"
+#include "minisat/mtl/Vec.h"
+#include "minisat/mtl/Heap.h"
+#include "minisat/mtl/Sort.h"
+#include "minisat/core/SolverTypes.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Microbenchmarks of the containers and the clause allocator, used the way the solver uses them:
+//
+//   vec       -- 'push' (the trail, learnt clauses), 'growTo' (one call per new variable, as
+//                'newVar()' and 'OccLists::init()' do) and 'shrink' (backtracking the trail),
+//   Heap      -- 'insert', 'decrease' (bumping the activity of a variable) and 'removeMin'
+//                (picking a branch variable) with the comparator of the decision heap,
+//   clauses   -- 'ClauseAllocator::alloc' and 'reloc' into a new region (garbage collection),
+//   OccLists  -- 'cleanAll' of the watch lists after half of the clauses were deleted,
+//   select    -- the lower half of the learnt clauses by activity, as 'reduceDB()' finds it,
+//   sort      -- the learnt clauses by activity, as 'reduceDB()' found the lower half before
+//                'select' (kept for comparison), and literals of clauses.
+//
+// The default sizes (scaled by '-scale') are those of a large industrial run: a million variables,
+// a million problem clauses and a hundred thousand learnt clauses. Every benchmark builds its input
+// again for each of the '-reps' repetitions, and only the operations themselves are timed; the table
+// gives the median and minimum time of a repetition and the median time per operation.
+
+//MM: modifications to original minisat source code
+namespace mtlbench {
+
+// Same layout and comparators as the (protected) helper structures of 'Solver':
+struct Watcher {
+    CRef cref;
+    Lit  blocker;
+    Watcher(CRef cr, Lit p) : cref(cr), blocker(p) {}
+};
+
+struct WatcherDeleted {
+    const ClauseAllocator& ca;
+    WatcherDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
+    bool operator()(const Watcher& w) const { return ca[w.cref].mark() == 1; }
+};
+
+struct VarOrderLt {
+    const vec<float>& activity;
+    VarOrderLt(const vec<float>& act) : activity(act) {}
+    bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
+};
+
+struct reduceDB_key {
+    float key, act;
+    CRef  cr;
+    bool operator < (const reduceDB_key& other) const { return key < other.key; }
+};
+
+
+// Sizes of one repetition:
+struct Sizes {
+    int vars;
+    int clauses;
+    int learnts;
+    int ops;     // Number of pushes, heap updates, etc.
+};
+
+
+static volatile uint64_t sink;   // Results are added here, so the compiler cannot drop the work.
+
+
+class Random {
+    uint64_t state;
+public:
+    Random(uint64_t seed) : state(seed * 2685821657736338717ULL + 1) {}
+    uint32_t next () { state ^= state >> 12; state ^= state << 25; state ^= state >> 27; return (uint32_t)((state * 2685821657736338717ULL) >> 32); }
+    int      range(int lo, int hi) { return lo + (int)(next() % (uint32_t)(hi - lo)); }   // In [lo, hi).
+    double   real () { return next() / 4294967296.0; }
+};
+
+
+class Timer {
+    std::chrono::steady_clock::time_point start;
+public:
+    Timer() : start(std::chrono::steady_clock::now()) {}
+    double seconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+};
+
+
+// Learnt clauses are long, problem clauses are short; both have distinct literals:
+static void randomClause(Random& rnd, int vars, bool learnt, vec<Lit>& ps)
+{
+    int size = learnt ? (rnd.range(0, 8) == 0 ? 2 : rnd.range(3, 50)) : rnd.range(2, 8);
+    ps.clear();
+    while (ps.size() < size){
+        Lit p = mkLit(rnd.range(0, vars), rnd.next() & 1);
+        int i;
+        for (i = 0; i < ps.size() && var(ps[i]) != var(p); i++);
+        if (i == ps.size()) ps.push(p);
+    }
+}
+
+static void randomClauses(Random& rnd, const Sizes& sz, ClauseAllocator& ca, vec<CRef>& cs, bool learnt, int n)
+{
+    vec<Lit> ps;
+    for (int i = 0; i < n; i++){
+        randomClause(rnd, sz.vars, learnt, ps);
+        CRef cr = ca.alloc(ps, learnt);
+        if (learnt) ca[cr].slot() = cs.size();
+        cs.push(cr);
+    }
+}
+
+
+//=================================================================================================
+// Benchmarks -- each returns the number of operations and the seconds they took:
+
+
+static uint64_t vecPush(const Sizes& sz, Random&, double& secs)
+{
+    vec<Lit> trail;
+    Timer    t;
+    for (int i = 0; i < sz.ops; i++)
+        trail.push(mkLit(i & 0xfffff, i & 1));
+    secs = t.seconds();
+    sink += trail.size();
+    return sz.ops;
+}
+
+
+static uint64_t vecGrowTo(const Sizes& sz, Random&, double& secs)
+{
+    vec<float>         activity;
+    vec<vec<Watcher> > watches;
+    Timer              t;
+    for (int v = 0; v < sz.vars; v++){
+        activity.growTo(v + 1, 0);
+        watches .growTo(2*v + 2);
+    }
+    secs = t.seconds();
+    sink += activity.size() + watches.size();
+    return sz.vars;
+}
+
+
+static uint64_t vecShrink(const Sizes& sz, Random& rnd, double& secs)
+{
+    // The trail grows by a few literals per decision and is cut back to an earlier level on a conflict:
+    vec<int> depths;
+    for (int i = 0; i < sz.ops / 64; i++)
+        depths.push(rnd.range(1, 64));
+
+    vec<Lit> trail;
+    trail.capacity(sz.vars);
+    uint64_t ops = 0;
+    Timer    t;
+    for (int i = 0; i < depths.size(); i++){
+        for (int j = 0; j < depths[i] && trail.size() < sz.vars; j++)
+            trail.push(mkLit(j, false));
+        int back = trail.size() * depths[(i + 1) % depths.size()] / 64;
+        trail.shrink(back);
+        ops += back;
+    }
+    secs = t.seconds();
+    sink += trail.size();
+    return ops;
+}
+
+
+static uint64_t heapInsert(const Sizes& sz, Random& rnd, double& secs)
+{
+    vec<float> activity;
+    for (int v = 0; v < sz.vars; v++)
+        activity.push((float)rnd.real());
+
+    Heap<VarOrderLt> heap((VarOrderLt(activity)));
+    Timer            t;
+    for (int v = 0; v < sz.vars; v++)
+        heap.insert(v);
+    secs = t.seconds();
+    sink += heap.size();
+    return sz.vars;
+}
+
+
+static uint64_t heapDecrease(const Sizes& sz, Random& rnd, double& secs)
+{
+    // Bumps follow 'varBumpActivity()': a few variables are bumped often, and the increment grows
+    // after every 64 bumps (about one conflict).
+    vec<float> activity;
+    for (int v = 0; v < sz.vars; v++)
+        activity.push(0);
+    vec<Var> bumps;
+    for (int i = 0; i < sz.ops; i++)
+        bumps.push(rnd.range(0, 4) == 0 ? rnd.range(0, sz.vars) : rnd.range(0, sz.vars / 100 + 1));
+
+    Heap<VarOrderLt> heap((VarOrderLt(activity)));
+    for (int v = 0; v < sz.vars; v++)
+        heap.insert(v);
+
+    double inc = 1;
+    Timer  t;
+    for (int i = 0; i < bumps.size(); i++){
+        activity[bumps[i]] = float(activity[bumps[i]] + inc);
+        heap.decrease(bumps[i]);
+        if ((i & 63) == 63) inc *= 1.0 / 0.95;
+        if (inc > 1e30){
+            for (int v = 0; v < sz.vars; v++) activity[v] *= 1e-30f;
+            inc *= 1e-30; }
+    }
+    secs = t.seconds();
+    sink += heap[0];
+    return sz.ops;
+}
+
+
+static uint64_t heapRemoveMin(const Sizes& sz, Random& rnd, double& secs)
+{
+    vec<float> activity;
+    for (int v = 0; v < sz.vars; v++)
+        activity.push((float)rnd.real());
+
+    Heap<VarOrderLt> heap((VarOrderLt(activity)));
+    for (int v = 0; v < sz.vars; v++)
+        heap.insert(v);
+
+    uint64_t sum = 0;
+    Timer    t;
+    while (!heap.empty())
+        sum += heap.removeMin();
+    secs = t.seconds();
+    sink += sum;
+    return sz.vars;
+}
+
+
+static uint64_t regionAlloc(const Sizes& sz, Random& rnd, double& secs)
+{
+    vec<vec<Lit> > clauses(sz.clauses);
+    for (int i = 0; i < sz.clauses; i++)
+        randomClause(rnd, sz.vars, i % 4 == 0, clauses[i]);
+
+    ClauseAllocator ca;
+    Timer           t;
+    for (int i = 0; i < sz.clauses; i++)
+        ca.alloc(clauses[i], i % 4 == 0);
+    secs = t.seconds();
+    sink += ca.size();
+    return sz.clauses;
+}
+
+
+static uint64_t regionReloc(const Sizes& sz, Random& rnd, double& secs)
+{
+    // As 'garbageCollect()': half of the learnt clauses were removed, the rest move to a new region.
+    ClauseAllocator ca;
+    vec<CRef>       clauses, learnts;
+    randomClauses(rnd, sz, ca, clauses, false, sz.clauses);
+    randomClauses(rnd, sz, ca, learnts, true, sz.learnts);
+    int i, j;
+    for (i = j = 0; i < learnts.size(); i++)
+        if (rnd.next() & 1) ca.free(learnts[i]);
+        else learnts[j++] = learnts[i];
+    learnts.shrink(i - j);
+
+    Timer           t;
+    ClauseAllocator to(ca.size() - ca.wasted());
+    for (i = 0; i < learnts.size(); i++) ca.reloc(learnts[i], to);
+    for (i = 0; i < clauses.size(); i++) ca.reloc(clauses[i], to);
+    to.moveTo(ca);
+    secs = t.seconds();
+    sink += ca.size();
+    return clauses.size() + learnts.size();
+}
+
+
+static uint64_t occListsClean(const Sizes& sz, Random& rnd, double& secs)
+{
+    ClauseAllocator ca;
+    vec<CRef>       clauses;
+    randomClauses(rnd, sz, ca, clauses, false, sz.clauses);
+
+    OccLists<Lit, vec<Watcher>, WatcherDeleted> watches((WatcherDeleted(ca)));
+    for (int v = 0; v < sz.vars; v++){
+        watches.init(mkLit(v, false));
+        watches.init(mkLit(v, true)); }
+    for (int i = 0; i < clauses.size(); i++){
+        const Clause& c = ca[clauses[i]];
+        watches[~c[0]].push(Watcher(clauses[i], c[1]));
+        watches[~c[1]].push(Watcher(clauses[i], c[0])); }
+
+    // As 'removeClause()' with strict detaching off: mark the clause and smudge its two lists.
+    uint64_t watchers = 2 * (uint64_t)clauses.size();
+    for (int i = 0; i < clauses.size(); i++)
+        if (rnd.next() & 1){
+            Clause& c = ca[clauses[i]];
+            c.mark(1);
+            watches.smudge(~c[0]);
+            watches.smudge(~c[1]); }
+
+    Timer t;
+    watches.cleanAll();
+    secs = t.seconds();
+    sink += watches[mkLit(0, false)].size();
+    return watchers;
+}
+
+
+static uint64_t sortReduceDB(const Sizes& sz, Random& rnd, double& secs)
+{
+    ClauseAllocator ca;
+    vec<CRef>       learnts;
+    vec<float>      learnt_act;
+    randomClauses(rnd, sz, ca, learnts, true, sz.learnts);
+    for (int i = 0; i < learnts.size(); i++)
+        learnt_act.push((float)rnd.real());
+
+    // (Building the keys is part of the work, as 'reduceDB()' did it for every call.)
+    Timer             t;
+    vec<reduceDB_key> keys(learnts.size());
+    for (int i = 0; i < learnts.size(); i++){
+        keys[i].key = ca[learnts[i]].size() > 2 ? learnt_act[i] : HUGE_VALF;
+        keys[i].act = learnt_act[i];
+        keys[i].cr  = learnts[i]; }
+    sort(keys);
+    secs = t.seconds();
+    sink += keys[0].cr;
+    return learnts.size();
+}
+
+
+static uint64_t selectReduceDB(const Sizes& sz, Random& rnd, double& secs)
+{
+    ClauseAllocator ca;
+    vec<CRef>       learnts;
+    vec<float>      learnt_act;
+    randomClauses(rnd, sz, ca, learnts, true, sz.learnts);
+    for (int i = 0; i < learnts.size(); i++)
+        learnt_act.push((float)rnd.real());
+
+    // (Reading the keys is part of the work, as 'reduceDB()' does it for every call.)
+    Timer      t;
+    vec<float> keys, sel;
+    for (int i = 0; i < learnts.size(); i++)
+        keys.push(ca[learnts[i]].size() > 2 ? learnt_act[i] : HUGE_VALF);
+    keys.copyTo(sel);
+    int half = sel.size() / 2;
+    std::nth_element(sel.begin(), sel.begin() + (half - 1), sel.end());
+    int below = 0;
+    for (int i = 0; i < keys.size(); i++)
+        if (keys[i] < sel[half - 1]) below++;
+    secs = t.seconds();
+    sink += below;
+    return learnts.size();
+}
+
+
+static uint64_t sortLits(const Sizes& sz, Random& rnd, double& secs)
+{
+    // As 'addClause()' and 'analyze()': many short sorts, mostly below the selection sort threshold.
+    vec<vec<Lit> > clauses(sz.clauses);
+    for (int i = 0; i < sz.clauses; i++)
+        randomClause(rnd, sz.vars, i % 4 == 0, clauses[i]);
+
+    uint64_t lits = 0;
+    Timer    t;
+    for (int i = 0; i < clauses.size(); i++){
+        sort(clauses[i]);
+        lits += clauses[i].size(); }
+    secs = t.seconds();
+    sink += toInt(clauses[0][0]);
+    return lits;
+}
+
+
+typedef uint64_t (*Benchmark)(const Sizes& sz, Random& rnd, double& secs);
+
+static const struct {
+    const char* name;
+    Benchmark   run;
+} benchmarks[] = {
+    { "vec.push",          vecPush        },
+    { "vec.growTo",        vecGrowTo      },
+    { "vec.shrink",        vecShrink      },
+    { "heap.insert",       heapInsert     },
+    { "heap.decrease",     heapDecrease   },
+    { "heap.removeMin",    heapRemoveMin  },
+    { "clauses.alloc",     regionAlloc    },
+    { "clauses.reloc",     regionReloc    },
+    { "occlists.cleanAll", occListsClean  },
+    { "sort.reduceDB",     sortReduceDB   },
+    { "select.reduceDB",   selectReduceDB },
+    { "sort.lits",         sortLits       },
+};
+
+
+static double median(vec<double>& xs)
+{
+    sort(xs);
+    int n = xs.size();
+    return n == 0 ? 0 : n % 2 == 1 ? xs[n/2] : (xs[n/2-1] + xs[n/2]) / 2;
+}
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    try {
+        setUsageHelp("USAGE: %s [options]\n\n  Times the containers and the clause allocator with sizes of large solver runs.\n");
+
+        IntOption    reps  ("MAIN", "reps",   "Number of repetitions of each benchmark.", 5, IntRange(1, INT32_MAX));
+        DoubleOption scale ("MAIN", "scale",  "Scale of the default sizes (1M variables and clauses, 100k learnt clauses).", 1, DoubleRange(0, false, 100, true));
+        StringOption filter("MAIN", "filter", "Only run the benchmarks whose name contains this string.");
+        IntOption    seed  ("MAIN", "seed",   "Seed of the random inputs.", 1, IntRange(0, INT32_MAX));
+
+        parseOptions(argc, argv, true);
+
+        Sizes sz;
+        sz.vars    = (int)(1000000 * scale) + 1;
+        sz.clauses = (int)(1000000 * scale) + 1;
+        sz.learnts = (int)( 100000 * scale) + 1;
+        sz.ops     = (int)(4000000 * scale) + 64;
+
+        printf("%-20s %12s %12s %12s %10s\n", "benchmark", "ops", "median (ms)", "min (ms)", "ns/op");
+        for (int b = 0; b < (int)(sizeof(benchmarks) / sizeof(benchmarks[0])); b++){
+            if (filter != NULL && strstr(benchmarks[b].name, filter) == NULL)
+                continue;
+
+            vec<double> times;
+            uint64_t    ops = 0;
+            for (int r = 0; r < reps; r++){
+                Random rnd(seed + r);
+                double secs = 0;
+                ops = benchmarks[b].run(sz, rnd, secs);
+                times.push(secs);
+            }
+            double med = median(times);
+            printf("%-20s %12" PRIu64 " %12.3f %12.3f %10.2f\n",
+                   benchmarks[b].name, ops, med * 1000, times[0] * 1000, ops > 0 ? med * 1e9 / ops : 0);
+            fflush(stdout);
+        }
+        exit(0);
+    } catch (OutOfMemoryException&){
+        fprintf(stderr, "===============================================================================\n");
+        fprintf(stderr, "INDETERMINATE\n");
+        exit(0);
+    }
+}
+
+//MM: modifications to original minisat source code
+} //namespace mtlbench
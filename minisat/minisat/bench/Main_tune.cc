@@ -0,0 +1,388 @@
+/***********************************************************************************[Main_tune.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <thread>
+
+#include "minisat/utils/System.h"
+#include "minisat/utils/Options.h"
+#include "minisat/mtl/Sort.h"
+#include "minisat/core/Dimacs.h"
+#include "minisat/core/SolverConfig.h"
+#include "minisat/simp/SimpSolver.h"
+#include "minisat/bench/BenchUtils.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Offline parameter tuner -- searches, for every family of instances of one or more lists (the
+// family is the directory of an instance, as 'aim' in 'SAT/aim/aim-50-1_6-yes1-1.cnf'), for the
+// parameters of 'SolverConfig' that solve the family fastest, by successive halving:
+//
+//   - '-configs' configurations are drawn at random from the ranges in 'params[]' (the first is
+//     the defaults, so they stay in the race unless they are beaten),
+//   - every configuration still in the race solves every instance of the family, with a cut-off
+//     of '-cutoff' wall-clock seconds per run; a configuration is scored by its PAR2 time (the sum
+//     of its run times, with a run that hits the cut-off counted as twice the cut-off) and is out
+//     of the race if it gives a wrong answer,
+//   - the best 1/'-eta' of the configurations go to the next round, with the cut-off multiplied
+//     by '-eta', until one is left or the run times add up to '-budget' seconds (wall-clock seconds
+//     summed over the runs, so '-threads' N use it up about N times as fast; runs in progress are
+//     finished, so the budget can be overrun by up to one cut-off per thread).
+//
+// The runs of a round are spread over '-threads' threads, each run solving with its own solver
+// (the solvers only read their 'SolverConfig'). Run times are wall-clock times of one thread, so
+// there should not be more threads than free cores.
+//
+// The best configuration of each family is written to '-out' as a line of command-line options
+// after the family name, which can be given to 'minisat' or 'minisat_simp' as they are:
+//
+//   minisat_simp $(grep '^aim ' tuned.txt | cut -d' ' -f2-) <input-file>
+
+//MM: modifications to original minisat source code
+namespace tune {
+
+struct Param {
+    const char*            name;     // Name of the option.
+    double SolverConfig::* dbl;      // Exactly one of 'dbl', 'num' and 'flag' is set.
+    int    SolverConfig::* num;
+    bool   SolverConfig::* flag;
+    double                 lo, hi;   // Range to draw from ('dbl' and 'num').
+    bool                   log;      // Draw uniformly on a logarithmic scale.
+    bool                   simp;     // Only used with '-simp'.
+};
+
+static const Param params[] = {
+    { "var-decay",    &SolverConfig::var_decay,    NULL,                            NULL,                         0.75,  0.99,   false, false },
+    { "cla-decay",    &SolverConfig::clause_decay, NULL,                            NULL,                         0.99,  0.9999, false, false },
+    { "rfirst",       NULL,                        &SolverConfig::restart_first,    NULL,                         25,    800,    true,  false },
+    { "rinc",         &SolverConfig::restart_inc,  NULL,                            NULL,                         1.1,   4,      false, false },
+    { "luby",         NULL,                        NULL,                            &SolverConfig::luby_restart,  0,     0,      false, false },
+    { "phase-saving", NULL,                        &SolverConfig::phase_saving,     NULL,                         0,     2,      false, false },
+    { "gc-frac",      &SolverConfig::garbage_frac, NULL,                            NULL,                         0.05,  0.5,    false, false },
+    { "viv-int",      NULL,                        &SolverConfig::viv_interval,     NULL,                         0,     32,     false, false },
+    { "grow",         NULL,                        &SolverConfig::grow,             NULL,                         0,     16,     false, true  },
+    { "cl-lim",       NULL,                        &SolverConfig::clause_lim,       NULL,                         5,     100,    true,  true  },
+    { "sub-lim",      NULL,                        &SolverConfig::subsumption_lim,  NULL,                         100,   10000,  true,  true  },
+};
+
+static const int nParams = (int)(sizeof(params) / sizeof(params[0]));
+
+
+struct Candidate {
+    SolverConfig config;
+    double       score;      // PAR2 seconds in the last round it ran in,
+    double       cutoff;     // and the cut-off of that round.
+    bool         wrong;      // Gave a wrong answer (and is out of the race).
+};
+
+struct Job {
+    int          cand, inst;
+    double       time;       // Wall-clock seconds of the run ('HUGE_VAL' if it was stopped).
+    bool         wrong;
+};
+
+
+// Returns a random float 0 <= x < 1 (the generator of 'Solver'). Seed must never be 0.
+static double drand(double& seed)
+{
+    seed *= 1389796;
+    int q = (int)(seed / 2147483647);
+    seed -= (double)q * 2147483647;
+    return seed / 2147483647;
+}
+
+
+static void drawConfig(SolverConfig& c, bool simp, double& seed)
+{
+    for (int i = 0; i < nParams; i++){
+        const Param& p = params[i];
+        if (p.simp && !simp) continue;
+        double r = drand(seed);
+        double x = p.log ? exp(log(p.lo) + r * (log(p.hi) - log(p.lo))) : p.lo + r * (p.hi - p.lo);
+        if      (p.dbl  != NULL) c.*p.dbl  = x;
+        else if (p.num  != NULL) c.*p.num  = p.log ? (int)floor(x + 0.5) : (int)floor(p.lo + r * (p.hi - p.lo + 1));
+        else                     c.*p.flag = r < 0.5;
+    }
+}
+
+
+// Writes the tuned parameters of 'c' as command-line options:
+static void printConfig(FILE* out, const SolverConfig& c, bool simp)
+{
+    for (int i = 0; i < nParams; i++){
+        const Param& p = params[i];
+        if (p.simp && !simp) continue;
+        if      (p.dbl != NULL) fprintf(out, " -%s=%.6g", p.name, c.*p.dbl);
+        else if (p.num != NULL) fprintf(out, " -%s=%d", p.name, c.*p.num);
+        else                    fprintf(out, " -%s%s", c.*p.flag ? "" : "no-", p.name);
+    }
+}
+
+
+// The family of an instance is its directory without the answer ('SAT/aim/x.cnf' -> 'aim'):
+static char* familyOf(const char* name)
+{
+    const char* start = name;
+    if      (strncmp(start, "SAT/",   4) == 0) start += 4;
+    else if (strncmp(start, "UNSAT/", 6) == 0) start += 6;
+    const char* end = strrchr(start, '/');
+    return end == NULL ? copyString(".", 1) : copyString(start, (int)(end - start));
+}
+
+
+// Solves one instance with one configuration; returns FALSE if the file could not be read:
+static bool runJob(const char* path, bool expect_sat, const SolverConfig& config, bool simp, double cutoff, Job& job)
+{
+    FILE* in = NULL;
+    fopen_s(&in, path, "rb");
+    if (in == NULL)
+        return false;
+
+    SimpSolver* SS = simp ? new SimpSolver(config) : NULL;
+    Solver*     S  = simp ? SS : new Solver(config);
+    S->verbosity = 0;
+    if (simp) parse_DIMACS(in, *SS);
+    else      parse_DIMACS(in, *S);
+    fclose(in);
+
+    double wall0 = realTime();
+    lbool  ret;
+    {
+        Watchdog watchdog(*S, cutoff);
+        vec<Lit> dummy;
+        if (simp)
+            ret = !SS->eliminate(true) ? l_False : SS->solveLimited(dummy);
+        else
+            ret = !S->simplify() ? l_False : S->solveLimited(dummy);
+    }
+    double wall = realTime() - wall0;
+    delete S;
+
+    job.time  = ret == l_Undef ? HUGE_VAL : wall;
+    job.wrong = ret != l_Undef && (ret == l_True) != expect_sat;
+    return true;
+}
+
+
+struct CandidateLt {
+    const vec<Candidate>& cands;
+    CandidateLt(const vec<Candidate>& c) : cands(c) {}
+    bool operator()(int x, int y) const {
+        return cands[x].wrong != cands[y].wrong ? cands[y].wrong
+             : cands[x].score != cands[y].score ? cands[x].score < cands[y].score : x < y; }
+};
+
+
+// Races the candidates on the instances of one family; returns the index of the winner:
+static int race(const char* dir, const vec<char*>& insts, vec<Candidate>& cands, bool simp,
+                double cutoff, double eta, double budget, int threads)
+{
+    vec<int> alive;
+    for (int i = 0; i < cands.size(); i++)
+        alive.push(i);
+
+    // Wall-clock time of the runs so far, in microseconds (a run that was stopped counts as the cut-off):
+    std::atomic<int64_t> spent(0);
+    for (int round = 0;; round++){
+        vec<Job> jobs;
+        for (int c = 0; c < alive.size(); c++)
+            for (int i = 0; i < insts.size(); i++){
+                Job j;
+                j.cand  = alive[c];
+                j.inst  = i;
+                j.time  = 0;
+                j.wrong = false;
+                jobs.push(j); }
+
+        // Runs are not started once the budget is used up; a round cut short in this way does not
+        // count, and the race ends with the ranking of the round before (the defaults first, when
+        // that is the first round):
+        std::atomic<int>  next(0), done(0);
+        std::atomic<bool> missing(false);
+        auto work = [&]{
+            char path[4096];
+            for (int k; spent < budget * 1e6 && (k = next.fetch_add(1)) < jobs.size();){
+                Job&        j    = jobs[k];
+                const char* name = insts[j.inst];
+                snprintf(path, sizeof(path), "%s/%s", dir, name);
+                if (!runJob(path, strncmp(name, "SAT/", 4) == 0, cands[j.cand].config, simp, cutoff, j))
+                    missing = true;
+                spent += (int64_t)((j.time == HUGE_VAL ? cutoff : j.time) * 1e6);
+                done++;
+            } };
+        vec<std::thread*> pool;
+        for (int t = 1; t < threads && t < jobs.size(); t++)
+            pool.push(new std::thread(work));
+        work();
+        for (int t = 0; t < pool.size(); t++){
+            pool[t]->join();
+            delete pool[t]; }
+        if (missing)
+            fprintf(stderr, "ERROR! Could not open an instance of the family.\n"), exit(1);
+        if (done < jobs.size()){
+            printf("  round %d: %3d configurations, cut-off %8.3f s, budget used up after %d of %d runs\n",
+                   round, alive.size(), cutoff, (int)done, jobs.size());
+            break; }
+
+        // Score the candidates (in the order of the jobs, so the sums do not depend on the threads):
+        for (int c = 0; c < alive.size(); c++){
+            cands[alive[c]].score  = 0;
+            cands[alive[c]].cutoff = cutoff; }
+        for (int k = 0; k < jobs.size(); k++){
+            Candidate& c = cands[jobs[k].cand];
+            double     t = jobs[k].time == HUGE_VAL ? 2 * cutoff : jobs[k].time;
+            c.score += t;
+            c.wrong |= jobs[k].wrong;
+        }
+        sort(alive, CandidateLt(cands));
+
+        for (int c = 0; c < alive.size(); c++)
+            if (cands[alive[c]].wrong){
+                fprintf(stderr, "WARNING! A configuration gave a wrong answer:");
+                printConfig(stderr, cands[alive[c]].config, simp);
+                fprintf(stderr, "\n"); }
+
+        printf("  round %d: %3d configurations, cut-off %8.3f s, best %10.4f s, spent %8.1f s%s\n",
+               round, alive.size(), cutoff, cands[alive[0]].score, spent / 1e6, find(alive, 0) ? "" : " (defaults out)");
+        fflush(stdout);
+
+        if (alive.size() == 1 || cands[alive[0]].wrong)
+            break;
+        int keep = (int)(alive.size() / eta);
+        alive.shrink(alive.size() - (keep < 1 ? 1 : keep));
+        cutoff *= eta;
+    }
+    return alive[0];
+}
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    try {
+        setUsageHelp("USAGE: %s [options]\n\n  Tunes the solver parameters for every family of instances in the given lists.\n");
+
+        StringOption dir      ("MAIN", "inputs",   "Directory of the instances (the names in the lists are relative to it).", "tests/inputs");
+        StringOption lists    ("MAIN", "lists",    "Comma separated lists of instances (relative to '-inputs').", "easy.txt");
+        StringOption families ("MAIN", "families", "If given, only tune these (comma separated) families.");
+        IntOption    nconfigs ("MAIN", "configs",  "Number of configurations in the first round (the first are the defaults).", 27, IntRange(1, INT32_MAX));
+        DoubleOption eta      ("MAIN", "eta",      "Fraction of the configurations kept each round is 1/eta; the cut-off grows by eta.", 3, DoubleRange(1, false, HUGE_VAL, false));
+        DoubleOption cutoff   ("MAIN", "cutoff",   "Wall-clock seconds of a run in the first round.", 0.5, DoubleRange(0, false, HUGE_VAL, false));
+        DoubleOption budget   ("MAIN", "budget",   "Wall-clock seconds of the runs of one family, summed over the runs.", 600, DoubleRange(0, false, HUGE_VAL, false));
+        IntOption    threads  ("MAIN", "threads",  "Number of runs at the same time (0 = number of cores).", 0, IntRange(0, 1024));
+        DoubleOption seed     ("MAIN", "seed",     "Seed of the random configurations.", 91648253, DoubleRange(0, false, HUGE_VAL, false));
+        BoolOption   simp     ("MAIN", "simp",     "Preprocess with 'SimpSolver', and tune its parameters as well.", true);
+        StringOption out_name ("MAIN", "out",      "File to write the best configuration of each family to.", "tuned.txt");
+
+        parseOptions(argc, argv, true);
+
+        int nthreads = threads > 0 ? (int)threads : (int)std::thread::hardware_concurrency();
+        if (nthreads < 1) nthreads = 1;
+
+        // Collect the instances and their families:
+        vec<char*> names;
+        for (const char* list = lists; *list != '\0';){
+            const char* end = strchr(list, ',');
+            int         len = end == NULL ? (int)strlen(list) : (int)(end - list);
+            char        path[4096];
+            snprintf(path, sizeof(path), "%s/%.*s", (const char*)dir, len, list);
+            if (len > 0 && !readList(path, names))
+                fprintf(stderr, "ERROR! Could not open file: %s\n", path), exit(1);
+            list += len + (end != NULL);
+        }
+
+        vec<char*> fams;
+        for (int i = 0; i < names.size(); i++){
+            char* f = familyOf(names[i]);
+            int   k;
+            for (k = 0; k < fams.size() && strcmp(fams[k], f) != 0; k++);
+            if (families != NULL){
+                const char* s = strstr(families, f);
+                int         n = (int)strlen(f);
+                if (s == NULL || (s != (const char*)families && s[-1] != ',') || (s[n] != ',' && s[n] != '\0')){
+                    free(f);
+                    continue; }
+            }
+            if (k == fams.size()) fams.push(f);
+            else                  free(f);
+        }
+        if (fams.size() == 0)
+            fprintf(stderr, "ERROR! No instances to tune on.\n"), exit(1);
+
+        FILE* out = NULL;
+        fopen_s(&out, out_name, "wb");
+        if (out == NULL)
+            fprintf(stderr, "ERROR! Could not open file: %s\n", (const char*)out_name), exit(1);
+        fprintf(out, "# family options\n");
+
+        double rnd = seed;
+        for (int f = 0; f < fams.size(); f++){
+            vec<char*> insts;
+            for (int i = 0; i < names.size(); i++){
+                char* g = familyOf(names[i]);
+                if (strcmp(g, fams[f]) == 0) insts.push(names[i]);
+                free(g); }
+
+            vec<Candidate> cands;
+            for (int c = 0; c < nconfigs; c++){
+                Candidate cand;
+                if (c > 0) drawConfig(cand.config, simp, rnd);
+                cand.score  = 0;
+                cand.cutoff = 0;
+                cand.wrong  = false;
+                cands.push(cand); }
+
+            printf("%s: %d instances\n", fams[f], insts.size());
+            fflush(stdout);
+            int best = race(dir, insts, cands, simp, cutoff, eta, budget, nthreads);
+
+            if (cands[best].wrong){
+                fprintf(out, "# %s: every configuration gave a wrong answer\n", fams[f]);
+                continue;
+            }else if (cands[best].cutoff == 0){
+                fprintf(out, "# %s: the budget did not allow a round, defaults kept\n", fams[f]);
+                continue; }
+            fprintf(out, "# %s: %d instances, PAR2 %.4f s with cut-off %.3f s (defaults: %.4f s with cut-off %.3f s)\n",
+                    fams[f], insts.size(), cands[best].score, cands[best].cutoff, cands[0].score, cands[0].cutoff);
+            fprintf(out, "%s", fams[f]);
+            printConfig(out, cands[best].config, simp);
+            fprintf(out, "\n");
+            printf("  best:");
+            printConfig(stdout, cands[best].config, simp);
+            printf("\n");
+            fflush(stdout);
+        }
+        fclose(out);
+
+        exit(0);
+    } catch (OutOfMemoryException&){
+        fprintf(stderr, "===============================================================================\n");
+        fprintf(stderr, "INDETERMINATE\n");
+        exit(0);
+    }
+}
+
+//MM: modifications to original minisat source code
+} //namespace tune
@@ -0,0 +1,109 @@
+/***********************************************************************************[DratWriter.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/core/DratWriter.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Constructor/Destructor:
+
+
+DratWriter::DratWriter(FILE* out_, bool binary_, int buffer_size_) :
+    out        (out_)
+  , binary     (binary_)
+  , buffer_size(buffer_size_)
+  , stop       (false)
+  , closed     (false)
+  , n_added    (0)
+  , n_deleted  (0)
+  , n_bytes    (0)
+{
+    // Leave some headroom so that a single lemma rarely forces a reallocation:
+    buf    .capacity(buffer_size + 4096);
+    pending.capacity(buffer_size + 4096);
+    writer = std::thread(&DratWriter::writerMain, this);
+}
+
+
+DratWriter::~DratWriter()
+{
+    close();
+}
+
+
+//=================================================================================================
+// Buffer management:
+
+
+// Give the current buffer to the writer thread. Waits only if the previous hand-over is still
+// being written.
+void DratWriter::handOver()
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    cond.wait(lock, [this]{ return pending.size() == 0; });
+    buf.swap(pending);
+    n_bytes += pending.size();
+    cond.notify_all();
+}
+
+
+void DratWriter::flush()
+{
+    if (closed) return;
+    if (buf.size() > 0)
+        handOver();
+
+    std::unique_lock<std::mutex> lock(mtx);
+    cond.wait(lock, [this]{ return pending.size() == 0; });
+    fflush(out);
+}
+
+
+void DratWriter::close()
+{
+    if (closed) return;
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+    }
+    cond.notify_all();
+    writer.join();
+    closed = true;
+}
+
+
+void DratWriter::writerMain()
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    for (;;){
+        cond.wait(lock, [this]{ return stop || pending.size() > 0; });
+        if (pending.size() == 0 && stop)
+            break;
+
+        // Write without holding the lock, so the solver can keep filling its own buffer. The
+        // solver never touches 'pending' while it is non-empty:
+        lock.unlock();
+        if (fwrite((uint8_t*)pending, 1, pending.size(), out) != (size_t)pending.size())
+            fprintf(stderr, "WARNING! Failed to write DRAT proof.\n");
+        lock.lock();
+
+        pending.clear();
+        cond.notify_all();
+    }
+}
@@ -0,0 +1,141 @@
+/************************************************************************************[DratWriter.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_DratWriter_h
+#define Minisat_DratWriter_h
+
+#include <stdio.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// DratWriter -- emits a DRAT proof of unsatisfiability:
+//
+// Lemmas and deletions are encoded into an in-memory buffer by the solver thread. Full buffers
+// are handed over to a background thread that performs the actual (blocking) file writes, so the
+// solver only ever pays for the encoding. Two buffers are used in turn, i.e. the solver blocks
+// only if the disk cannot keep up with a whole buffer worth of proof.
+
+class DratWriter {
+public:
+    DratWriter(FILE* out, bool binary = true, int buffer_size = 1 << 20);
+    ~DratWriter();
+
+    template<class Lits>
+    void addClause    (const Lits& c)             { encode('a', c, lit_Undef); }
+    template<class Lits>
+    void addClause    (const Lits& c, Lit except) { encode('a', c, except); }  // Add 'c' without the literal 'except'.
+    template<class Lits>
+    void deleteClause (const Lits& c)             { encode('d', c, lit_Undef); }
+    void addEmptyClause();
+
+    void flush        ();  // Block until everything encoded so far has reached the file.
+    void close        ();  // Flush and stop the writer thread. Does not close the underlying file.
+
+    uint64_t added    () const { return n_added; }
+    uint64_t deleted  () const { return n_deleted; }
+    uint64_t bytes    () const { return n_bytes; }
+
+private:
+    FILE*                   out;
+    bool                    binary;
+    int                     buffer_size;
+    vec<uint8_t>            buf;          // Buffer being filled by the solver.
+    vec<uint8_t>            pending;      // Buffer being written by the writer thread.
+    bool                    stop;
+    bool                    closed;
+    std::mutex              mtx;
+    std::condition_variable cond;
+    std::thread             writer;
+
+    uint64_t                n_added, n_deleted, n_bytes;
+
+    template<class Lits>
+    void encode       (char kind, const Lits& c, Lit except);
+    void putLit       (Lit p);
+    void putEnd       ();
+    void handOver     ();
+    void writerMain   ();
+};
+
+
+//=================================================================================================
+// Implementation of inline methods:
+
+template<class Lits>
+inline void DratWriter::encode(char kind, const Lits& c, Lit except)
+{
+    if (kind == 'a') n_added++; else n_deleted++;
+
+    if (binary)
+        buf.push((uint8_t)kind);
+    else if (kind == 'd'){
+        buf.push('d'); buf.push(' '); }
+
+    for (int i = 0; i < c.size(); i++)
+        if (c[i] != except)
+            putLit(c[i]);
+    putEnd();
+
+    if (buf.size() >= buffer_size)
+        handOver();
+}
+
+inline void DratWriter::putLit(Lit p)
+{
+    if (binary){
+        // Variable-length encoding of '2 * (var + 1) + sign', 7 bits at a time, low bits first:
+        uint32_t u = (uint32_t)toInt(p) + 2;
+        while (u > 127){
+            buf.push((uint8_t)(128 | (u & 127)));
+            u >>= 7; }
+        buf.push((uint8_t)u);
+    }else{
+        char  tmp[16];
+        int   n = sprintf(tmp, "%s%d ", sign(p) ? "-" : "", var(p) + 1);
+        for (int i = 0; i < n; i++)
+            buf.push((uint8_t)tmp[i]);
+    }
+}
+
+inline void DratWriter::putEnd()
+{
+    if (binary)
+        buf.push(0);
+    else{
+        buf.push('0'); buf.push('\n'); }
+}
+
+inline void DratWriter::addEmptyClause()
+{
+    n_added++;
+    if (binary) buf.push('a');
+    putEnd();
+}
+
+
+//=================================================================================================
+}
+
+#endif
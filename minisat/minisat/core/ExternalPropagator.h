@@ -0,0 +1,56 @@
+/****************************************************************************[ExternalPropagator.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_ExternalPropagator_h
+#define Minisat_ExternalPropagator_h
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// ExternalPropagator -- domain specific propagation on top of the clauses (as IPASIR-UP):
+//
+// Connected with 'Solver::connectPropagator()'. The solver notifies the propagator of the
+// assignments of the variables registered with 'Solver::addObservedVar()' (in trail order, after
+// unit propagation over the clauses reached a fixpoint), of every new decision level and of every
+// backtrack. It then calls 'propagate()' until it returns 'lit_Undef'; a literal that is already
+// false is a conflict. Reasons are lazy: 'addReasonClause()' is only called when conflict analysis
+// needs the reason of a literal, and the clause must have been implied when the literal was
+// propagated. Reason clauses are stored as learnt clauses (they are not part of a DRAT proof).
+//
+// A propagator that does not change the assignment must have no effect on the solver, and the
+// solver only pays a test of the connected propagator when there is none.
+
+class ExternalPropagator {
+public:
+    virtual ~ExternalPropagator() {}
+
+    virtual void notifyAssignment      (Lit p, bool is_fixed) = 0;  // 'p' became true ('is_fixed': at the root level, for good).
+    virtual void notifyNewDecisionLevel()                     = 0;
+    virtual void notifyBacktrack       (int new_level)        = 0;  // The assignments above 'new_level' were undone.
+
+    virtual Lit  propagate             ()                     { return lit_Undef; }  // A literal implied by the assignment (or 'lit_Undef').
+    virtual void addReasonClause       (Lit p, vec<Lit>& out_clause) = 0;           // A clause with 'p' whose other literals are false.
+    virtual Lit  decide                ()                     { return lit_Undef; }  // The next decision (or 'lit_Undef' to let the solver pick).
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*************************************************************************************[Features.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <string.h>
+
+#include "minisat/core/Features.h"
+#include "minisat/core/SolverConfig.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Constructor:
+
+
+InstanceFeatures::InstanceFeatures() :
+    vars(0), clauses(0), len_mean(0), binary_frac(0), ternary_frac(0), neg_binary_frac(0), horn_frac(0)
+  , clause_var_ratio(0), deg_mean(0), deg_max(0), deg_cv(0), preset(-1)
+{
+    for (int i = 0; i < 7; i++) len_hist[i] = 0;
+}
+
+
+//=================================================================================================
+// Preset selection:
+//
+//   sudoku       -- mostly binary clauses of two negative literals: the pairwise at-most-one
+//                   constraints of Sudoku and other assignment problems; only for large ones, as
+//                   on small ones (as 'pigeon-hole') leaving out the probing makes no difference,
+//   random,      -- (nearly) all clauses ternary, over variables of about the same degree: random
+//   unsat-heavy     3-SAT, above the ratio of 4.26 clauses per variable (where random 3-SAT
+//                   becomes unsatisfiable) 'unsat-heavy',
+//   industrial   -- large problems,
+//   default      -- the rest.
+
+
+const char* InstanceFeatures::selectPreset()
+{
+    const char* name;
+    if (neg_binary_frac >= 0.5 && clauses >= 100000)
+        name = "sudoku";
+    else if (ternary_frac >= 0.95 && deg_cv < 0.5)
+        name = clause_var_ratio >= 4.26 ? "unsat-heavy" : "random";
+    else if (vars >= 50000 || clauses >= 200000)
+        name = "industrial";
+    else
+        name = "default";
+
+    for (int i = 0; i < SolverConfig::nPresets(); i++)
+        if (strcmp(SolverConfig::presetName(i), name) == 0)
+            preset = i;
+    return name;
+}
+
+
+//=================================================================================================
+// Statistics export:
+
+
+void InstanceFeatures::registerStats(StatsRegistry& reg) const
+{
+    static const char* hist_names[7] = { "feat_len_1", "feat_len_2", "feat_len_3", "feat_len_4", "feat_len_5_8", "feat_len_9_16", "feat_len_17" };
+
+    reg.add("feat_vars",             &vars);
+    reg.add("feat_clauses",          &clauses);
+    for (int i = 0; i < 7; i++)
+        reg.add(hist_names[i],       &len_hist[i]);
+    reg.add("feat_len_mean",         &len_mean);
+    reg.add("feat_binary_frac",      &binary_frac);
+    reg.add("feat_ternary_frac",     &ternary_frac);
+    reg.add("feat_neg_binary_frac",  &neg_binary_frac);
+    reg.add("feat_horn_frac",        &horn_frac);
+    reg.add("feat_clause_var_ratio", &clause_var_ratio);
+    reg.add("feat_deg_mean",         &deg_mean);
+    reg.add("feat_deg_max",          &deg_max);
+    reg.add("feat_deg_cv",           &deg_cv);
+    reg.add("feat_preset",           &preset);
+}
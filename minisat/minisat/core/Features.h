@@ -0,0 +1,59 @@
+/**************************************************************************************[Features.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Features_h
+#define Minisat_Features_h
+
+#include "minisat/utils/Stats.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// InstanceFeatures -- cheap syntactic features of a problem, for choosing a preset:
+//
+// Filled in by 'Solver::extractFeatures()' (one pass over the original clauses, meant to run right
+// after parsing). Fractions are of the clauses, units included. The degree of a variable is the
+// number of clauses it occurs in.
+
+struct InstanceFeatures {
+    double vars;
+    double clauses;
+    double len_hist[7];             // Clauses of length 1, 2, 3, 4, 5-8, 9-16 and more.
+    double len_mean;
+    double binary_frac;
+    double ternary_frac;
+    double neg_binary_frac;         // Binary clauses of two negative literals (as at-most-one encodings).
+    double horn_frac;               // Clauses with at most one positive literal.
+    double clause_var_ratio;
+    double deg_mean, deg_max;
+    double deg_cv;                  // Standard deviation of the degrees over their mean.
+    double preset;                  // Index of the preset selected by 'selectPreset()' (-1 = none).
+
+    InstanceFeatures();
+
+    // Returns the preset for problems with these features (one of 'SolverConfig::presetName()'):
+    const char* selectPreset();
+
+    // Adds the features to 'reg' as "feat_<name>" (they are read when a record is written, so this
+    // can happen before they are extracted):
+    void        registerStats(StatsRegistry& reg) const;
+};
+
+//=================================================================================================
+}
+
+#endif
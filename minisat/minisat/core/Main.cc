@@ -27,6 +27,10 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "minisat/utils/Options.h"
 #include "minisat/core/Dimacs.h"
 #include "minisat/core/Solver.h"
+#include "minisat/core/DratWriter.h"
+#include "minisat/utils/Stats.h"
+#include "minisat/core/Features.h"
+#include "minisat/core/Portfolio.h"
 
 using namespace Minisat;
 
@@ -55,13 +59,38 @@ void printStats(Solver& solver)
     fprintf(stderr, "decisions             : %-12" PRIu64 "   (%4.2f %% random) (%.0f /sec)\n", solver.decisions, (float)solver.rnd_decisions*100 / (float)solver.decisions, solver.decisions   /cpu_time);
     fprintf(stderr, "propagations          : %-12" PRIu64 "   (%.0f /sec)\n", solver.propagations, solver.propagations/cpu_time);
     fprintf(stderr, "conflict literals     : %-12" PRIu64 "   (%4.2f %% deleted)\n", solver.tot_literals, (solver.max_literals - solver.tot_literals)*100 / (double)solver.max_literals);
+    if (solver.reduce_dbs > 0)
+        fprintf(stderr, "reduceDB              : %-12" PRIu64 "   (%.3f ms/call)\n", solver.reduce_dbs, solver.reduce_time*1000 / solver.reduce_dbs);
 #   ifndef __MINGW32__
     if (mem_used != 0) fprintf(stderr, "Memory used           : %.2f MB\n", mem_used);
 #   endif
+    if (solver.proof != NULL)
+        fprintf(stderr, "proof                 : %-12" PRIu64 "   (%" PRIu64 " deleted, %.2f MB)\n", solver.proof->added(), solver.proof->deleted(), solver.proof->bytes() / (1024.0*1024.0));
+    solver.profile.print(stderr);
     fprintf(stderr, "CPU time              : %g s\n", cpu_time);
 }
 
 
+// Write out what is left of the proof before leaving through 'exit()' (which skips destructors):
+static void closeProof(Solver& solver)
+{
+    if (solver.proof != NULL){
+        solver.proof->close();
+        delete solver.proof;
+        solver.proof = NULL; }
+}
+
+
+// Write the final statistics record before leaving through 'exit()':
+static void closeStats(StatsRegistry& stats, FILE* stats_file, int status)
+{
+    if (stats_file != NULL){
+        stats.set("status", status);
+        stats.write("final");
+        fclose(stats_file); }
+}
+
+
 static Solver* solver;
 #if    ! (defined(__MINGW32__) || defined(_MSC_VER))
 // Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
@@ -100,12 +129,62 @@ int main(int argc, char** argv)
         IntOption    verb   ("MAIN", "verb",   "Verbosity level (0=silent, 1=some, 2=more).", 1, IntRange(0, 2));
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        StringOption drat   ("MAIN", "drat",   "If given, write a DRAT proof of unsatisfiability to this file.");
+        BoolOption   drat_bin("MAIN", "drat-binary", "Use the binary DRAT encoding for the proof.", true);
+        StringOption stats_name("MAIN", "stats", "If given, write machine readable statistics to this file at exit.");
+        StringOption stats_fmt ("MAIN", "stats-format", "Format of the statistics file (json or csv).", "json");
+        DoubleOption stats_int ("MAIN", "stats-interval", "Seconds between statistics records while solving (0 = only at exit).", 0, DoubleRange(0, true, HUGE_VAL, false));
+        StringOption preset    ("MAIN", "preset", "Parameters for a kind of instance, under the options given explicitly (auto, default, sudoku, industrial, unsat-heavy, random).", "auto");
+        IntOption    threads   ("MAIN", "threads", "Number of solvers run in parallel, sharing short learnt clauses.", 1, IntRange(1, 64));
+        BoolOption   determ    ("MAIN", "deterministic", "Exchange clauses at barriers, so parallel runs are repeatable.", true);
+        IntOption    sync_props("MAIN", "sync-props", "Propagations of each solver before a clause exchange (at its next restart).", 50000, IntRange(1, INT32_MAX));
+        IntOption    share_len ("MAIN", "share-len", "Longest learnt clause shared between solvers.", 8, IntRange(1, INT32_MAX));
         
         parseOptions(argc, argv, true);
 
-        Solver S;
+        SolverConfig config;
+        bool auto_preset = strcmp(preset, "auto") == 0;   // Selected from the features of the problem, after parsing.
+        if (!auto_preset && !config.applyPreset(preset))
+            fprintf(stderr, "ERROR! Unknown preset: %s\n", (const char*)preset), exit(1);
+        config.readCoreOptions();
+
+        if (threads > 1 && drat)
+            fprintf(stderr, "ERROR! A DRAT proof can not be written with more than one thread.\n"), exit(1);
+
+        Solver S(config);
         double initial_time = cpuTime();
 
+        Portfolio P(S, threads, determ);
+        bool      parallel = threads > 1;
+        P.sync_props = sync_props;
+        P.share_len  = share_len;
+        if (parallel)
+            P.setConfig(config);
+
+		//MM: modifications to original minisat source code
+        FILE* proof_file = NULL;
+        if (drat){
+            fopen_s(&proof_file, drat, "wb");
+            if (proof_file == NULL)
+                fprintf(stderr, "ERROR! Could not open proof file: %s\n", (const char*)drat), exit(1);
+            S.proof = new DratWriter(proof_file, drat_bin); }
+
+        InstanceFeatures features;
+        StatsRegistry    stats;
+        FILE*            stats_file = NULL;
+        if (stats_name){
+            fopen_s(&stats_file, stats_name, "wb");
+            if (stats_file == NULL)
+                fprintf(stderr, "ERROR! Could not open statistics file: %s\n", (const char*)stats_name), exit(1);
+            S.registerStats(stats);
+            features.registerStats(stats);
+            if (parallel) P.registerStats(stats);
+            stats.set("parse_time", 0);
+            stats.set("solve_time", 0);
+            stats.set("status", 0);
+            stats.open(stats_file, strcmp(stats_fmt, "csv") == 0 ? StatsRegistry::fmt_CSV : StatsRegistry::fmt_JSON, stats_int);
+            S.stats = &stats; }
+
         S.verbosity = verb;
         
         solver = &S;
@@ -143,7 +222,9 @@ int main(int argc, char** argv)
 		//MM: modifications to original minisat source code
         //FILE* in = (argc == 1) ? fdopen(0, "rb") : fopen(argv[1], "rb");
 		FILE* in = NULL;
-		if(argc == 1) 
+		if (argc == 1)
+			in = stdin;
+		else
 			fopen_s(&in, argv[1], "rb");
         if (in == NULL)
             fprintf(stderr, "ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
@@ -152,7 +233,10 @@ int main(int argc, char** argv)
             fprintf(stderr, "============================[ Problem Statistics ]=============================\n");
             fprintf(stderr, "|                                                                             |\n"); }
         
-        parse_DIMACS(in, S);
+        if (parallel)
+            parse_DIMACS(in, P);
+        else
+            parse_DIMACS(in, S);
         fclose(in);
 		//MM: modifications to original minisat source code
         //FILE* res = argc >= 3 ? fopen(argv[2], "wb") : stdout;
@@ -163,8 +247,22 @@ int main(int argc, char** argv)
         if (S.verbosity > 0){
             fprintf(stderr, "|  Number of variables:  %12d                                         |\n", S.nVars());
             fprintf(stderr, "|  Number of clauses:    %12d                                         |\n", S.nClauses()); }
+
+        S.extractFeatures(features);
+        if (auto_preset){
+            const char* name = features.selectPreset();
+            config = SolverConfig();
+            config.applyPreset(name);
+            config.readCoreOptions();
+            if (parallel)
+                P.setConfig(config);
+            else
+                S.setConfig(config);
+            if (S.verbosity > 0)
+                fprintf(stderr, "|  Preset:               %12s (selected)                              |\n", name); }
         
         double parsed_time = cpuTime();
+        stats.set("parse_time", parsed_time - initial_time);
         if (S.verbosity > 0){
             fprintf(stderr, "|  Parse time:           %12.2f s                                       |\n", parsed_time - initial_time);
             fprintf(stderr, "|                                                                             |\n"); }
@@ -184,13 +282,21 @@ int main(int argc, char** argv)
                 printStats(S);
                 fprintf(stderr, "\n"); }
             fprintf(stderr, "UNSATISFIABLE\n");
+            closeProof(S);
+            if (proof_file != NULL) fclose(proof_file);
+            stats.set("solve_time", cpuTime() - parsed_time);
+            closeStats(stats, stats_file, 20);
             exit(20);
         }
         
         vec<Lit> dummy;
-        lbool ret = S.solveLimited(dummy);
+        lbool ret = parallel ? P.solve() : S.solveLimited(dummy);
         if (S.verbosity > 0){
             printStats(S);
+            if (parallel){
+                fprintf(stderr, "threads               : %d (%s)\n", P.nSolvers(), P.deterministic ? "deterministic" : "nondeterministic");
+                fprintf(stderr, "winner                : %d   (%" PRIu64 " epochs)\n", P.winner, P.epochs);
+                fprintf(stderr, "shared clauses        : %" PRIu64 "   (%" PRIu64 " imported)\n", P.exported, P.imported); }
             fprintf(stderr, "\n"); }
         fprintf(stderr, ret == l_True ? "SATISFIABLE\n" : ret == l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
         if (res != NULL){
@@ -207,6 +313,11 @@ int main(int argc, char** argv)
             fclose(res);
         }
         
+        closeProof(S);
+        if (proof_file != NULL) fclose(proof_file);
+        stats.set("solve_time", cpuTime() - parsed_time);
+        closeStats(stats, stats_file, ret == l_True ? 10 : ret == l_False ? 20 : 0);
+
 #ifdef NDEBUG
         exit(ret == l_True ? 10 : ret == l_False ? 20 : 0);     // (faster than "return", which will invoke the destructor for 'Solver')
 #else
@@ -0,0 +1,314 @@
+/************************************************************************************[Portfolio.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <thread>
+
+#include "minisat/core/Portfolio.h"
+#include "minisat/utils/Stats.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Constructor/Destructor:
+
+
+Portfolio::Portfolio(Solver& first, int threads, bool deterministic_) :
+    deterministic(deterministic_)
+  , sync_props   (50000)
+  , share_len    (8)
+  , winner       (-1)
+  , epochs       (0)
+  , exported     (0)
+  , imported     (0)
+  , arrived      (0)
+  , generation   (0)
+  , stop         (false)
+{
+    solvers.push(&first);
+    for (int i = 1; i < threads; i++)
+        solvers.push(new Solver());
+    for (int i = 0; i < threads; i++){
+        Worker* w   = new Worker;
+        w->P        = this;
+        w->id       = i;
+        w->cursor   = 0;
+        w->status   = l_Undef;
+        w->finished = false;
+        w->stopped  = false;
+        w->exported = 0;
+        w->imported = 0;
+        workers.push(w); }
+}
+
+
+Portfolio::~Portfolio()
+{
+    for (int i = 1; i < solvers.size(); i++)
+        delete solvers[i];
+    for (int i = 0; i < workers.size(); i++)
+        delete workers[i];
+}
+
+
+// The first solver gets 'config' as it is; the others a seed of their own and a random initial
+// activity (which only has an effect on the variables added after this):
+void Portfolio::setConfig(const SolverConfig& config)
+{
+    for (int i = 0; i < solvers.size(); i++){
+        SolverConfig c = config;
+        if (i > 0){
+            c.random_seed  = config.random_seed + i;
+            c.rnd_init_act = true; }
+        solvers[i]->setConfig(c);
+    }
+}
+
+
+Var Portfolio::newVar()
+{
+    Var v = var_Undef;
+    for (int i = 0; i < solvers.size(); i++)
+        v = solvers[i]->newVar();
+    return v;
+}
+
+
+bool Portfolio::addClause_(vec<Lit>& ps)
+{
+    // ('addClause_()' may change its argument, so every solver gets a copy.)
+    vec<Lit> copy;
+    bool     ok = true;
+    for (int i = 0; i < solvers.size(); i++){
+        ps.copyTo(copy);
+        ok &= solvers[i]->addClause_(copy); }
+    return ok;
+}
+
+
+//=================================================================================================
+// Clause exchange:
+
+
+void Portfolio::exportClause(void* state, const vec<Lit>& c)
+{
+    Worker& w = *(Worker*)state;
+    if (c.size() > w.P->share_len) return;
+    for (int i = 0; i < c.size(); i++)
+        w.out.push(c[i]);
+    w.out.push(lit_Undef);
+    w.exported++;
+}
+
+
+void Portfolio::import(Worker& w, const Lit* c)
+{
+    w.tmp.clear();
+    for (; *c != lit_Undef; c++)
+        w.tmp.push(*c);
+    solvers[w.id]->importClause(w.tmp);
+    w.imported++;
+}
+
+
+void Portfolio::barrier()
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    uint64_t gen = generation;
+    if (++arrived == solvers.size()){
+        arrived = 0;
+        generation++;
+        cv.notify_all();
+    }else
+        cv.wait(lock, [this, gen]{ return generation != gen; });
+}
+
+
+// Returns TRUE if the run is over. Every solver comes here once per epoch, finished or not:
+bool Portfolio::syncDeterministic(Worker& w)
+{
+    barrier();
+
+    // Between the barriers, only the own 'out' is read by others and nothing else is written:
+    bool over = false;
+    for (int i = 0; i < workers.size(); i++)
+        over |= workers[i]->finished;
+
+    if (over){
+        if (w.id == 0)
+            for (int i = workers.size() - 1; i >= 0; i--)
+                if (workers[i]->finished && workers[i]->status != l_Undef)
+                    winner = i;
+    }else
+        for (int i = 0; i < workers.size(); i++)
+            if (i != w.id)
+                for (int k = 0; k < workers[i]->out.size(); k++){
+                    import(w, &workers[i]->out[k]);
+                    while (workers[i]->out[k] != lit_Undef) k++; }
+
+    if (w.id == 0) epochs++;
+    barrier();
+    w.out.clear();
+    return over;
+}
+
+
+void Portfolio::syncPool(Worker& w)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+
+    // Publish the clauses of 'w':
+    for (int k = 0; k < w.out.size(); k++){
+        Shared s = { w.id, pool_lits.size() };
+        pool.push(s);
+        for (; w.out[k] != lit_Undef; k++)
+            pool_lits.push(w.out[k]);
+        pool_lits.push(lit_Undef); }
+    w.out.clear();
+
+    // Import the clauses of the others:
+    for (; w.cursor < pool.size(); w.cursor++)
+        if (pool[w.cursor].from != w.id)
+            import(w, &pool_lits[pool[w.cursor].start]);
+    if (w.id == 0) epochs++;
+
+    // Drop the clauses every solver has seen, once they are half of the pool:
+    int seen = w.cursor;
+    for (int i = 0; i < workers.size(); i++)
+        if (workers[i]->cursor < seen) seen = workers[i]->cursor;
+    if (seen > 0 && 2 * seen >= pool.size()){
+        int lits = seen < pool.size() ? pool[seen].start : pool_lits.size();
+        for (int i = seen; i < pool.size(); i++){
+            pool[i - seen]        = pool[i];
+            pool[i - seen].start -= lits; }
+        pool.shrink(seen);
+        for (int i = lits; i < pool_lits.size(); i++)
+            pool_lits[i - lits] = pool_lits[i];
+        pool_lits.shrink(lits);
+        for (int i = 0; i < workers.size(); i++)
+            workers[i]->cursor -= seen;
+    }
+}
+
+
+void Portfolio::sync(void* state)
+{
+    Worker&    w = *(Worker*)state;
+    Portfolio& P = *w.P;
+    if (!P.deterministic)
+        P.syncPool(w);
+    else if (P.syncDeterministic(w)){
+        w.stopped = true;
+        P.solvers[w.id]->interrupt(); }
+}
+
+
+bool Portfolio::terminate(void* state)
+{
+    return ((Worker*)state)->P->stop;
+}
+
+
+//=================================================================================================
+// Solving:
+
+
+void Portfolio::run(Worker& w)
+{
+    Solver& S = *solvers[w.id];
+    S.learnt_callback    = exportClause;
+    S.learnt_state       = &w;
+    S.sync_callback      = sync;
+    S.sync_state         = &w;
+    S.sync_props         = sync_props;
+    S.terminate_callback = deterministic ? NULL : terminate;
+    S.terminate_state    = &w;
+
+    vec<Lit> dummy;
+    lbool    ret = S.solveLimited(dummy);
+
+    if (deterministic){
+        // A solver stopped at a barrier is done; one that finished waits for the others at the next:
+        if (!w.stopped){
+            w.status   = ret;
+            w.finished = true;
+            syncDeterministic(w); }
+    }else{
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!stop){
+            stop   = true;
+            winner = ret != l_Undef ? w.id : -1; }
+        w.status   = ret;
+        w.finished = true;
+    }
+
+    S.learnt_callback    = NULL;
+    S.sync_callback      = NULL;
+    S.terminate_callback = NULL;
+    S.clearInterrupt();     // (Set by a barrier, or by 'terminate()' in the losers, in either mode.)
+}
+
+
+lbool Portfolio::solve()
+{
+    winner = -1;
+    stop   = false;
+    pool.clear();
+    pool_lits.clear();
+    for (int i = 0; i < workers.size(); i++){
+        Worker& w = *workers[i];
+        w.out.clear();
+        w.cursor   = 0;
+        w.status   = l_Undef;
+        w.finished = false;
+        w.stopped  = false; }
+
+    vec<std::thread*> threads;
+    for (int i = 1; i < workers.size(); i++)
+        threads.push(new std::thread([this, i]{ run(*workers[i]); }));
+    run(*workers[0]);
+    for (int i = 0; i < threads.size(); i++){
+        threads[i]->join();
+        delete threads[i]; }
+
+    exported = imported = 0;
+    for (int i = 0; i < workers.size(); i++){
+        exported += workers[i]->exported;
+        imported += workers[i]->imported; }
+
+    if (winner < 0)
+        return l_Undef;
+    lbool ret = workers[winner]->status;
+    if (ret == l_True && winner != 0)
+        solvers[winner]->model.copyTo(solvers[0]->model);
+    return ret;
+}
+
+
+//=================================================================================================
+// Statistics export:
+
+
+void Portfolio::registerStats(StatsRegistry& reg)
+{
+    reg.add("threads",              [this]{ return (double)solvers.size(); });
+    reg.add("winner",               &winner);
+    reg.add("epochs",               &epochs);
+    reg.add("shared_clauses",       &exported);
+    reg.add("imported_clauses",     &imported);
+    reg.add("total_propagations",   [this]{ double n = 0; for (int i = 0; i < solvers.size(); i++) n += solvers[i]->propagations; return n; });
+    reg.add("total_conflicts",      [this]{ double n = 0; for (int i = 0; i < solvers.size(); i++) n += solvers[i]->conflicts; return n; });
+}
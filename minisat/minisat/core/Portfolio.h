@@ -0,0 +1,133 @@
+/*************************************************************************************[Portfolio.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Portfolio_h
+#define Minisat_Portfolio_h
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Portfolio -- solvers with different seeds on one thread each, sharing their short learnt clauses:
+//
+// The first solver is given (and keeps the model of the run); the others are created with the
+// configuration of 'setConfig()', diversified by the index of the solver. The solvers export the
+// clauses they learn of at most 'share_len' literals, and exchange them at sync points: the first
+// restart of each solver after every 'sync_props' of its propagations (see 'Solver::sync_callback').
+//
+// Deterministic mode: the sync points are barriers for all solvers (an "epoch" is the work between
+// two of them), and each solver imports the clauses of the others in a canonical order (by the
+// index of the solver that learnt them, then in the order they were learnt). A solver that
+// finishes waits at the next barrier; the winner is the lowest index that finished in the first
+// epoch any did. So the same problem, number of threads and configuration always give the same
+// winner, model and statistics. The price is waiting at every barrier for the slowest solver.
+//
+// Otherwise, a solver exchanges clauses through a common pool whenever it reaches a sync point,
+// and the first solver to finish wins.
+//
+// Cost of the barriers: only measured on a machine with a single CPU, where waiting costs no time
+// (the other solvers run meanwhile). So the CPU time of each solver between barriers was recorded,
+// and the wall time on as many cores as solvers estimated as the sum over the epochs of the slowest
+// solver (ignoring the wake-up at each barrier). With the default 'sync_props', the solvers would
+// be busy for 85% (2 threads) and 84% (4 threads) of that time on 'tests/inputs/easy.txt', and
+// 90%, 94% and 89% (2, 4, 8 threads) on 15 random 3-SAT instances of 200-350 variables; the rest
+// is waiting, which the nondeterministic mode does not do. With 'sync_props' at 10000 it is 85%
+// and 74% on 'easy.txt'. On the single CPU, 'easy.txt' took 4.7-5.9 s with 4 deterministic
+// threads against 3.5-3.9 s nondeterministic (three runs each), as the deterministic solvers all
+// finish the epoch in which the first of them finished.
+
+class Portfolio {
+public:
+    Portfolio(Solver& first, int threads, bool deterministic);   // Call 'setConfig()' before adding variables.
+    ~Portfolio();
+
+    // Problem specification (as 'Solver', so 'parse_DIMACS()' reads into all solvers):
+    //
+    Var     newVar    ();
+    bool    addClause_(vec<Lit>& ps);
+    int     nVars     () const { return solvers[0]->nVars(); }
+
+    void    setConfig (const SolverConfig& config); // Set the parameters of the solvers (diversified).
+
+    // Solving:
+    //
+    lbool   solve     ();   // Copies the model of the winner into the first solver.
+
+    int     nSolvers  () const { return solvers.size(); }
+    Solver& solver    (int i)  { return *solvers[i]; }
+
+    // Parameters:
+    //
+    bool    deterministic;
+    int64_t sync_props;     // Propagations of a solver before a sync point.     (default 50000)
+    int     share_len;      // Longest learnt clause that is shared.             (default 8)
+
+    // Statistics: (read-only member variable)
+    //
+    int      winner;        // Index of the solver that finished first (-1 if none did).
+    uint64_t epochs, exported, imported;
+
+    void    registerStats(StatsRegistry& reg);
+
+private:
+    struct Worker {
+        Portfolio* P;
+        int        id;
+        vec<Lit>   out;       // Clauses to export, each followed by 'lit_Undef'.
+        int        cursor;    // (nondeterministic) Clauses of 'pool' imported so far.
+        lbool      status;    // Result of 'solve()' (when 'finished').
+        bool       finished;  // The solver returned from 'solve()' on its own.
+        bool       stopped;   // The solver was stopped because the run is over.
+        uint64_t   exported, imported;
+        vec<Lit>   tmp;
+    };
+
+    vec<Solver*>            solvers;
+    vec<Worker*>            workers;
+
+    // Deterministic mode:
+    std::mutex              mtx;
+    std::condition_variable cv;
+    int                     arrived;
+    uint64_t                generation;
+
+    // Nondeterministic mode (the pool is guarded by 'mtx'):
+    struct Shared { int from, start; };
+    vec<Shared>             pool;       // Clauses of all solvers: the solver and start in 'pool_lits'.
+    vec<Lit>                pool_lits;  // The literals of the clauses of 'pool', each followed by 'lit_Undef'.
+    std::atomic<bool>       stop;
+
+    void        barrier      ();
+    bool        syncDeterministic(Worker& w);
+    void        syncPool     (Worker& w);
+    void        import       (Worker& w, const Lit* c);
+    void        run          (Worker& w);
+
+    static void exportClause (void* state, const vec<Lit>& c);
+    static void sync         (void* state);
+    static bool terminate    (void* state);
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -19,9 +19,18 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include <math.h>
+#include <float.h>
+#include <algorithm>
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
 
 #include "minisat/mtl/Sort.h"
 #include "minisat/core/Solver.h"
+#include "minisat/core/DratWriter.h"
+#include "minisat/utils/System.h"
+#include "minisat/utils/Stats.h"
+#include "minisat/core/Features.h"
 
 using namespace Minisat;
 
@@ -30,55 +39,105 @@ using namespace Minisat;
 
 
 static const char* _cat = "CORE";
-
-static DoubleOption  opt_var_decay         (_cat, "var-decay",   "The variable activity decay factor",            0.95,     DoubleRange(0, false, 1, false));
-static DoubleOption  opt_clause_decay      (_cat, "cla-decay",   "The clause activity decay factor",              0.999,    DoubleRange(0, false, 1, false));
-static DoubleOption  opt_random_var_freq   (_cat, "rnd-freq",    "The frequency with which the decision heuristic tries to choose a random variable", 0, DoubleRange(0, true, 1, true));
-static DoubleOption  opt_random_seed       (_cat, "rnd-seed",    "Used by the random variable selection",         91648253, DoubleRange(0, false, HUGE_VAL, false));
-static IntOption     opt_ccmin_mode        (_cat, "ccmin-mode",  "Controls conflict clause minimization (0=none, 1=basic, 2=deep)", 2, IntRange(0, 2));
-static IntOption     opt_phase_saving      (_cat, "phase-saving", "Controls the level of phase saving (0=none, 1=limited, 2=full)", 2, IntRange(0, 2));
-static BoolOption    opt_rnd_init_act      (_cat, "rnd-init",    "Randomize the initial activity", false);
-static BoolOption    opt_luby_restart      (_cat, "luby",        "Use the Luby restart sequence", true);
-static IntOption     opt_restart_first     (_cat, "rfirst",      "The base restart interval", 100, IntRange(1, INT32_MAX));
-static DoubleOption  opt_restart_inc       (_cat, "rinc",        "Restart interval increase factor", 2, DoubleRange(1, false, HUGE_VAL, false));
-static DoubleOption  opt_garbage_frac      (_cat, "gc-frac",     "The fraction of wasted memory allowed before a garbage collection is triggered",  0.20, DoubleRange(0, false, HUGE_VAL, false));
+static const SolverConfig _def;     // The defaults.
+
+static DoubleOption  opt_var_decay         (_cat, "var-decay",   "The variable activity decay factor",            _def.var_decay,       DoubleRange(0, false, 1, false));
+static DoubleOption  opt_clause_decay      (_cat, "cla-decay",   "The clause activity decay factor",              _def.clause_decay,    DoubleRange(0, false, 1, false));
+static DoubleOption  opt_random_var_freq   (_cat, "rnd-freq",    "The frequency with which the decision heuristic tries to choose a random variable", _def.random_var_freq, DoubleRange(0, true, 1, true));
+static DoubleOption  opt_random_seed       (_cat, "rnd-seed",    "Used by the random variable selection",         _def.random_seed,     DoubleRange(0, false, HUGE_VAL, false));
+static IntOption     opt_ccmin_mode        (_cat, "ccmin-mode",  "Controls conflict clause minimization (0=none, 1=basic, 2=deep)", _def.ccmin_mode, IntRange(0, 2));
+static IntOption     opt_phase_saving      (_cat, "phase-saving", "Controls the level of phase saving (0=none, 1=limited, 2=full)", _def.phase_saving, IntRange(0, 2));
+static BoolOption    opt_rnd_init_act      (_cat, "rnd-init",    "Randomize the initial activity", _def.rnd_init_act);
+static BoolOption    opt_luby_restart      (_cat, "luby",        "Use the Luby restart sequence", _def.luby_restart);
+static IntOption     opt_restart_first     (_cat, "rfirst",      "The base restart interval", _def.restart_first, IntRange(1, INT32_MAX));
+static DoubleOption  opt_restart_inc       (_cat, "rinc",        "Restart interval increase factor", _def.restart_inc, DoubleRange(1, false, HUGE_VAL, false));
+static DoubleOption  opt_garbage_frac      (_cat, "gc-frac",     "The fraction of wasted memory allowed before a garbage collection is triggered",  _def.garbage_frac, DoubleRange(0, false, HUGE_VAL, false));
+static BoolOption    opt_reuse_trail       (_cat, "reuse-trail", "Keep the assumption levels between calls to solve", _def.reuse_trail);
+static IntOption     opt_viv_interval      (_cat, "viv-int",     "Vivify clauses every this many restarts (0 = never)", _def.viv_interval, IntRange(0, INT32_MAX));
+static DoubleOption  opt_viv_effort        (_cat, "viv-effort",  "Propagations of vivification, as a fraction of those of the search", _def.viv_effort, DoubleRange(0, true, HUGE_VAL, false));
+
+
+SolverConfig& SolverConfig::readCoreOptions()
+{
+    readIfGiven(var_decay,       opt_var_decay);
+    readIfGiven(clause_decay,    opt_clause_decay);
+    readIfGiven(random_var_freq, opt_random_var_freq);
+    readIfGiven(random_seed,     opt_random_seed);
+    readIfGiven(ccmin_mode,      opt_ccmin_mode);
+    readIfGiven(phase_saving,    opt_phase_saving);
+    readIfGiven(rnd_init_act,    opt_rnd_init_act);
+    readIfGiven(luby_restart,    opt_luby_restart);
+    readIfGiven(restart_first,   opt_restart_first);
+    readIfGiven(restart_inc,     opt_restart_inc);
+    readIfGiven(garbage_frac,    opt_garbage_frac);
+    readIfGiven(reuse_trail,     opt_reuse_trail);
+    readIfGiven(viv_interval,    opt_viv_interval);
+    readIfGiven(viv_effort,      opt_viv_effort);
+    return *this;
+}
 
 
 //=================================================================================================
 // Constructor/Destructor:
 
 
-Solver::Solver() :
+Solver::Solver() : Solver(SolverConfig().readCoreOptions()) {}
+
+
+Solver::Solver(const SolverConfig& config) :
 
     // Parameters (user settable):
     //
     verbosity        (0)
-  , var_decay        (opt_var_decay)
-  , clause_decay     (opt_clause_decay)
-  , random_var_freq  (opt_random_var_freq)
-  , random_seed      (opt_random_seed)
-  , luby_restart     (opt_luby_restart)
-  , ccmin_mode       (opt_ccmin_mode)
-  , phase_saving     (opt_phase_saving)
+  , var_decay        (config.var_decay)
+  , clause_decay     (config.clause_decay)
+  , random_var_freq  (config.random_var_freq)
+  , random_seed      (config.random_seed)
+  , luby_restart     (config.luby_restart)
+  , ccmin_mode       (config.ccmin_mode)
+  , phase_saving     (config.phase_saving)
   , rnd_pol          (false)
-  , rnd_init_act     (opt_rnd_init_act)
-  , garbage_frac     (opt_garbage_frac)
-  , restart_first    (opt_restart_first)
-  , restart_inc      (opt_restart_inc)
+  , rnd_init_act     (config.rnd_init_act)
+  , garbage_frac     (config.garbage_frac)
+  , reuse_trail      (config.reuse_trail)
+  , viv_interval     (config.viv_interval)
+  , viv_effort       (config.viv_effort)
+  , restart_first    (config.restart_first)
+  , restart_inc      (config.restart_inc)
 
     // Parameters (the rest):
     //
-  , learntsize_factor((double)1/(double)3), learntsize_inc(1.1)
+  , learntsize_factor(config.learntsize_factor), learntsize_inc(config.learntsize_inc)
 
     // Parameters (experimental):
     //
   , learntsize_adjust_start_confl (100)
   , learntsize_adjust_inc         (1.5)
 
+    // Proof logging:
+    //
+  , proof                         (NULL)
+
+    // Statistics export:
+    //
+  , stats                         (NULL)
+
+    // Callbacks:
+    //
+  , terminate_callback            (NULL)
+  , terminate_state               (NULL)
+  , learnt_callback               (NULL)
+  , learnt_state                  (NULL)
+  , sync_callback                 (NULL)
+  , sync_state                    (NULL)
+  , sync_props                    (0)
+
     // Statistics: (formerly in 'SolverStats')
     //
   , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0)
   , dec_vars(0), clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+  , reduce_dbs(0), garbage_collects(0), reused_levels(0), ext_propagations(0), ext_reasons(0)
+  , vivified_clauses(0), vivified_lits(0), gc_time(0), reduce_time(0)
 
   , ok                 (true)
   , cla_inc            (1)
@@ -90,6 +149,10 @@ Solver::Solver() :
   , order_heap         (VarOrderLt(activity))
   , progress_estimate  (0)
   , remove_satisfied   (true)
+  , ext                (NULL)
+  , ext_qhead          (0)
+  , viv_props          (0)
+  , next_sync          (0)
 
     // Resource constraints:
     //
@@ -104,6 +167,27 @@ Solver::~Solver()
 }
 
 
+void Solver::setConfig(const SolverConfig& config)
+{
+    var_decay         = config.var_decay;
+    clause_decay      = config.clause_decay;
+    random_var_freq   = config.random_var_freq;
+    random_seed       = config.random_seed;
+    luby_restart      = config.luby_restart;
+    ccmin_mode        = config.ccmin_mode;
+    phase_saving      = config.phase_saving;
+    rnd_init_act      = config.rnd_init_act;
+    garbage_frac      = config.garbage_frac;
+    reuse_trail       = config.reuse_trail;
+    viv_interval      = config.viv_interval;
+    viv_effort        = config.viv_effort;
+    restart_first     = config.restart_first;
+    restart_inc       = config.restart_inc;
+    learntsize_factor = config.learntsize_factor;
+    learntsize_inc    = config.learntsize_inc;
+}
+
+
 //=================================================================================================
 // Minor methods:
 
@@ -119,10 +203,11 @@ Var Solver::newVar(bool sign, bool dvar)
     assigns  .push(l_Undef);
     vardata  .push(mkVarData(CRef_Undef, 0));
     //activity .push(0);
-    activity .push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
+    activity .push(rnd_init_act ? float(drand(random_seed) * 0.00001) : 0);
     seen     .push(0);
     polarity .push(sign);
     decision .push();
+    observed .push(0);
     trail    .capacity(v+1);
     setDecisionVar(v, dvar);
     return v;
@@ -130,10 +215,23 @@ Var Solver::newVar(bool sign, bool dvar)
 
 
 bool Solver::addClause_(vec<Lit>& ps)
+{
+    cancelUntil(0);
+    if (group_lits.size() > 0)
+        ps.push(~group_lits.last());
+    return addClauseNoGroup_(ps);
+}
+
+
+bool Solver::addClauseNoGroup_(vec<Lit>& ps)
 {
     assert(decisionLevel() == 0);
     if (!ok) return false;
 
+    // Keep the clause as given, in case it has to be replaced in the proof:
+    vec<Lit> oc;
+    if (proof) ps.copyTo(oc);
+
     // Check if clause is satisfied and remove false/duplicate literals:
     sort(ps);
     Lit p = lit_Undef;
@@ -152,11 +250,17 @@ bool Solver::addClause_(vec<Lit>& ps)
     }
     ps.truncate(j);
 
+    if (proof && ps.size() < oc.size()){
+        proof->addClause(ps);
+        proof->deleteClause(oc); }
+
     if (ps.empty()) {
         return ok = false;
     } else if (ps.size() == 1) {
         uncheckedEnqueue(ps[0]);
-        return ok = (propagate() == CRef_Undef);
+        ok = (propagate() == CRef_Undef);
+        if (proof && !ok) proof->addEmptyClause();
+        return ok;
     } else {
         CRef cr = ca.alloc(ps, false);
         clauses.push(cr);
@@ -167,6 +271,68 @@ bool Solver::addClause_(vec<Lit>& ps)
 }
 
 
+// Units are propagated right away; satisfied clauses are skipped and false literals removed:
+bool Solver::importClause(const vec<Lit>& ps)
+{
+    assert(decisionLevel() == 0);
+    if (!ok) return false;
+
+    add_tmp.clear();
+    for (int i = 0; i < ps.size(); i++)
+        if (value(ps[i]) == l_True)
+            return true;
+        else if (value(ps[i]) != l_False)
+            add_tmp.push(ps[i]);
+
+    if (add_tmp.size() == 0)
+        return ok = false;
+    else if (add_tmp.size() == 1){
+        uncheckedEnqueue(add_tmp[0]);
+        return ok = (propagate() == CRef_Undef);
+    }else{
+        CRef cr = ca.alloc(add_tmp, true);
+        pushLearnt(cr);
+        attachClause(cr);
+        claBumpActivity(ca[cr]);
+    }
+    return true;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  push : ()  ->  [void]
+|  pop  : ()  ->  [void]
+|
+|  Description:
+|    Clause groups are implemented with activation literals: a clause 'C' added to the group with
+|    activation literal 'a' is stored as 'C | ~a', and every call to 'solve()' assumes the activation
+|    literals of the open groups (before the assumptions of the user), so their clauses are active.
+|    A learnt clause derived from 'C' contains '~a' as well, since the assumptions are decisions and
+|    conflict clause minimization never removes a decision. 'pop()' adds the unit '~a': the clauses
+|    of the group and the learnt clauses derived from them become satisfied and are removed by the
+|    next 'simplify()' (or, in 'SimpSolver', by subsumption). Groups nest: a clause belongs to the
+|    innermost open group only, and groups must be popped in reverse order. The activation literals
+|    are not decision variables, and they never appear in 'conflict'. DRAT proofs do not cover
+|    groups (the unit added by 'pop()' is not implied by the clauses).
+|________________________________________________________________________________________________@*/
+void Solver::push()
+{
+    group_lits.push(mkLit(newVar(true, false)));
+}
+
+
+void Solver::pop()
+{
+    assert(group_lits.size() > 0);
+    cancelUntil(0);
+    add_tmp.clear();
+    add_tmp.push(~group_lits.last());
+    group_lits.pop();
+    addClauseNoGroup_(add_tmp);
+}
+
+
 void Solver::attachClause(CRef cr) {
     const Clause& c = ca[cr];
     assert(c.size() > 1);
@@ -195,6 +361,8 @@ void Solver::detachClause(CRef cr, bool strict) {
 
 void Solver::removeClause(CRef cr) {
     Clause& c = ca[cr];
+    // Reasons are kept in the proof, as checkers can not re-derive the implied units otherwise:
+    if (proof && !locked(c)) proof->deleteClause(c);
     detachClause(cr);
     // Don't leave pointers to free'd memory!
     if (locked(c)) vardata[var(c[0])].reason = CRef_Undef;
@@ -214,6 +382,9 @@ bool Solver::satisfied(const Clause& c) const {
 //
 void Solver::cancelUntil(int level) {
     if (decisionLevel() > level){
+        if (ext != NULL){
+            ext->notifyBacktrack(level);
+            if (ext_qhead > trail_lim[level]) ext_qhead = trail_lim[level]; }
         for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var      x  = var(trail[c]);
             assigns [x] = l_Undef;
@@ -234,6 +405,12 @@ Lit Solver::pickBranchLit()
 {
     Var next = var_Undef;
 
+    // Decision of the external propagator:
+    if (ext != NULL){
+        Lit p = ext->decide();
+        if (p != lit_Undef && value(p) == l_Undef)
+            return p; }
+
     // Random decision:
     if (drand(random_seed) < random_var_freq && !order_heap.empty()){
         next = order_heap[irand(random_seed,order_heap.size())];
@@ -271,6 +448,7 @@ Lit Solver::pickBranchLit()
 |________________________________________________________________________________________________@*/
 void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
 {
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_Analyze);
     int pathC = 0;
     Lit p     = lit_Undef;
 
@@ -280,11 +458,13 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
     int index   = trail.size() - 1;
 
     do{
+        if (confl == CRef_Lazy) confl = reasonClause(var(p));
         assert(confl != CRef_Undef); // (otherwise should be UIP)
         Clause& c = ca[confl];
 
         if (c.learnt())
             claBumpActivity(c);
+        profile.count(ctr_ResolvedLits, c.size());
 
         for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++){
             Lit q = c[j];
@@ -329,7 +509,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
             if (reason(x) == CRef_Undef)
                 out_learnt[j++] = out_learnt[i];
             else{
-                Clause& c = ca[reason(var(out_learnt[i]))];
+                Clause& c = ca[reasonClause(x)];
                 for (int k = 1; k < c.size(); k++)
                     if (!seen[var(c[k])] && level(var(c[k])) > 0){
                         out_learnt[j++] = out_learnt[i];
@@ -374,7 +554,7 @@ bool Solver::litRedundant(Lit p, uint32_t abstract_levels)
     int top = analyze_toclear.size();
     while (analyze_stack.size() > 0){
         assert(reason(var(analyze_stack.last())) != CRef_Undef);
-        Clause& c = ca[reason(var(analyze_stack.last()))]; analyze_stack.pop();
+        Clause& c = ca[reasonClause(var(analyze_stack.last()))]; analyze_stack.pop();
 
         for (int i = 1; i < c.size(); i++){
             Lit p  = c[i];
@@ -423,7 +603,7 @@ void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict)
                 assert(level(x) > 0);
                 out_conflict.push(~trail[i]);
             }else{
-                Clause& c = ca[reason(x)];
+                Clause& c = ca[reasonClause(x)];
                 for (int j = 1; j < c.size(); j++)
                     if (level(var(c[j])) > 0)
                         seen[var(c[j])] = 1;
@@ -450,14 +630,119 @@ void Solver::uncheckedEnqueue(Lit p, CRef from)
 |  propagate : [void]  ->  [Clause*]
 |
 |  Description:
-|    Propagates all enqueued facts. If a conflict arises, the conflicting clause is returned,
-|    otherwise CRef_Undef.
+|    Propagates all enqueued facts, over the clauses and with the external propagator (if one is
+|    connected). If a conflict arises, the conflicting clause is returned, otherwise CRef_Undef.
+|    A conflict of the external propagator may backtrack first, to the highest level of its clause.
 |
 |    Post-conditions:
 |      * the propagation queue is empty, even if there was a conflict.
 |________________________________________________________________________________________________@*/
 CRef Solver::propagate()
 {
+    if (ext == NULL)
+        return propagateClauses();
+
+    for (;;){
+        CRef confl = propagateClauses();
+        if (confl != CRef_Undef)
+            return confl;
+
+        // Pass the new assignments to the propagator:
+        for (; ext_qhead < trail.size(); ext_qhead++){
+            Lit p = trail[ext_qhead];
+            if (observed[var(p)])
+                ext->notifyAssignment(p, level(var(p)) == 0); }
+
+        // Enqueue the literals it implies (the reasons are asked for when needed):
+        bool enqueued = false;
+        for (Lit p = ext->propagate(); p != lit_Undef; p = ext->propagate()){
+            if (value(p) == l_True)
+                continue;
+            ext_propagations++;
+            if (value(p) == l_Undef){
+                uncheckedEnqueue(p, decisionLevel() == 0 ? CRef_Undef : CRef_Lazy);
+                enqueued = true;
+                continue; }
+
+            // Conflict: the clause may be falsified below the current level.
+            CRef cr = addExternalClause(p);
+            if (cr == CRef_Undef){
+                // The unit 'p':
+                cancelUntil(0);
+                if (value(p) == l_False)
+                    return CRef_Lazy;    // Contradiction at the root level (there is no clause, 'search()' does not need one).
+                uncheckedEnqueue(p);
+                enqueued = true;
+                continue; }
+            if (level(var(ca[cr][0])) < decisionLevel())
+                cancelUntil(level(var(ca[cr][0])));
+            return cr;
+        }
+        if (!enqueued)
+            return CRef_Undef;
+    }
+}
+
+
+// Returns the clause (attached as a learnt clause), or CRef_Undef for a unit. The literal of the
+// highest level is first and the one of the next highest level second, except that a true 'p' (that
+// is being propagated by the clause) stays first.
+CRef Solver::addExternalClause(Lit p)
+{
+    ext_tmp.clear();
+    ext->addReasonClause(p, ext_tmp);
+    ext_reasons++;
+
+    int i;
+    for (i = 0; i < ext_tmp.size() && ext_tmp[i] != p; i++);
+    assert(i < ext_tmp.size());
+    ext_tmp[i] = ext_tmp[0], ext_tmp[0] = p;
+
+    if (ext_tmp.size() == 1){
+        if (value(p) != l_True || level(var(p)) == 0)
+            return CRef_Undef;
+        // A unit reason above the root: weaken it with the first literal above the root (assigned
+        // before 'p'). If 'p' is that literal, it is never asked for a reason by conflict analysis.
+        Lit first = trail[trail_lim[0]];
+        if (first == p)
+            return CRef_Undef;
+        ext_tmp.push(~first);
+    }
+
+    for (int k = value(p) == l_True ? 1 : 0; k < 2; k++){
+        int max_i = k;
+        for (i = k+1; i < ext_tmp.size(); i++){
+            assert(value(ext_tmp[i]) == l_False);
+            if (level(var(ext_tmp[i])) > level(var(ext_tmp[max_i])))
+                max_i = i; }
+        Lit q = ext_tmp[max_i]; ext_tmp[max_i] = ext_tmp[k]; ext_tmp[k] = q;
+    }
+
+    CRef cr = ca.alloc(ext_tmp, true);
+    pushLearnt(cr);
+    attachClause(cr);
+    claBumpActivity(ca[cr]);
+    return cr;
+}
+
+
+void Solver::connectPropagator(ExternalPropagator* p)
+{
+    cancelUntil(0);
+    ext       = p;
+    ext_qhead = 0;
+}
+
+
+void Solver::addObservedVar(Var v)
+{
+    observed[v] = 1;
+}
+
+
+CRef Solver::propagateClauses()
+{
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_Propagate);
     CRef    confl     = CRef_Undef;
     int     num_props = 0;
     watches.cleanAll();
@@ -467,10 +752,12 @@ CRef Solver::propagate()
         vec<Watcher>&  ws  = watches[p];
         Watcher        *i, *j, *end;
         num_props++;
+        profile.watchList(toInt(p), ws.size());
 
         for (i = j = (Watcher*)ws, end = i + ws.size();  i != end;){
             // Try to avoid inspecting the clause:
             Lit blocker = i->blocker;
+            profile.count(ctr_Watchers);
             if (value(blocker) == l_True){
                 *j++ = *i++; continue; }
 
@@ -478,6 +765,7 @@ CRef Solver::propagate()
             CRef     cr        = i->cref;
             Clause&  c         = ca[cr];
             Lit      false_lit = ~p;
+            profile.count(ctr_ClauseVisits);
             if (c[0] == false_lit)
                 c[0] = c[1], c[1] = false_lit;
             assert(c[1] == false_lit);
@@ -490,10 +778,12 @@ CRef Solver::propagate()
                 *j++ = w; continue; }
 
             // Look for new watch:
+            profile.count(ctr_WatchSearches);
             for (int k = 2; k < c.size(); k++)
                 if (value(c[k]) != l_False){
                     c[1] = c[k]; c[k] = false_lit;
                     watches[~c[1]].push(w);
+                    profile.count(ctr_WatchMoves);
                     goto NextClause; }
 
             // Did not find watch -- clause is unit under assignment:
@@ -525,36 +815,175 @@ CRef Solver::propagate()
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
 |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|    The half with the lowest activity is found by selecting the median activity, without sorting
+|    the clauses; the clauses that stay keep their order in 'learnts'.
 |________________________________________________________________________________________________@*/
-namespace {
-    struct reduceDB_lt {
-        ClauseAllocator& ca;
-        reduceDB_lt(ClauseAllocator& ca_): ca(ca_) {}
-        bool operator () (CRef x, CRef y) {
-            return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity());
-        }
-    };
-}
 void Solver::reduceDB()
 {
     int     i, j;
     double  extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
-
-    sort(learnts, reduceDB_lt(ca));
-    // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
+    double  start_time = cpuTime();
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_ReduceDB);
+
+    reduce_dbs++;
+    // The keys are read in one pass over the clauses (binary clauses get 'HUGE_VALF', so they are
+    // never in the lower half); the selection then only goes through a copy of them:
+    vec<float>& keys = reduce_keys;
+    vec<float>& sel  = reduce_sel;
+    keys.clear();
+    for (i = 0; i < learnts.size(); i++)
+        keys.push(ca[learnts[i]].size() > 2 ? learnt_act[i] : HUGE_VALF);
+    int   half = learnts.size() / 2;
+    float lim  = -HUGE_VALF;    // Largest key of the lower half.
+    int   ties = 0;             // Clauses of key 'lim' in the lower half.
+    if (half > 0){
+        keys.copyTo(sel);
+        std::nth_element(sel.begin(), sel.begin() + (half - 1), sel.end());
+        lim  = sel[half - 1];
+        ties = half;
+        for (i = 0; i < keys.size(); i++)
+            if (keys[i] < lim) ties--;
+    }
+    // Don't delete binary or locked clauses. From the rest, delete clauses from the lower half
     // and clauses with activity smaller than 'extra_lim':
     for (i = j = 0; i < learnts.size(); i++){
-        Clause& c = ca[learnts[i]];
-        if (c.size() > 2 && !locked(c) && (i < learnts.size() / 2 || c.activity() < extra_lim))
+        Clause& c   = ca[learnts[i]];
+        bool    low = keys[i] < lim || (keys[i] == lim && ties-- > 0);
+        if (c.size() > 2 && !locked(c) && (low || learnt_act[i] < extra_lim))
             removeClause(learnts[i]);
-        else
-            learnts[j++] = learnts[i];
+        else{
+            c.slot()        = j;
+            learnts[j]      = learnts[i];
+            learnt_act[j++] = learnt_act[i]; }
     }
     learnts.shrink(i - j);
+    learnt_act.shrink(i - j);
+    reduce_time += cpuTime() - start_time;
     checkGarbage();
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  vivify : ()  ->  [bool]
+|
+|  Description:
+|    Vivify the most active learnt clauses, and the problem clauses unless 'SimpSolver' still keeps
+|    occurrence lists of them ('remove_satisfied' is off then): the negation of each literal of a
+|    clause is assumed in turn, and a literal is dropped if unit propagation over the other clauses
+|    makes it false, or ends the clause early if it makes it true or gives a conflict. Each clause
+|    is vivified once. Runs at level 0, between restarts, until it has done 'viv_effort' times the
+|    propagations of the search since the last call. Returns FALSE if the clauses are found to be
+|    unsatisfiable.
+|________________________________________________________________________________________________@*/
+namespace {
+    struct vivify_lt {
+        const vec<float>& act;
+        vivify_lt(const vec<float>& act_): act(act_) {}
+        bool operator () (int x, int y) { return act[x] > act[y]; }
+    };
+}
+bool Solver::vivify()
+{
+    assert(decisionLevel() == 0);
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_Vivify);
+
+    // The external propagator is not told about the levels opened here:
+    if (ext != NULL || !ok) return ok;
+
+    int64_t  budget = (int64_t)((propagations - viv_props) * viv_effort);
+    uint64_t start  = propagations;
+
+    vec<int>  slots;
+    vec<CRef> cands;
+    for (int i = 0; i < learnts.size(); i++){
+        const Clause& c = ca[learnts[i]];
+        if (c.size() > 2 && !c.vivified() && !satisfied(c))
+            slots.push(i); }
+    sort(slots, vivify_lt(learnt_act));
+    for (int i = 0; i < slots.size(); i++)
+        cands.push(learnts[slots[i]]);
+    if (remove_satisfied)
+        for (int i = 0; i < clauses.size(); i++){
+            const Clause& c = ca[clauses[i]];
+            if (c.size() > 2 && !c.vivified() && !satisfied(c))
+                cands.push(clauses[i]); }
+
+    // Assumed literals must not change the saved phases:
+    int saved_phase_saving = phase_saving;
+    phase_saving = 0;
+    uint64_t units = trail.size();
+    for (int i = 0; i < cands.size() && ok && (int64_t)(propagations - start) < budget; i++)
+        vivifyClause(cands[i]);
+    phase_saving = saved_phase_saving;
+
+    // Clauses that became units are freed already:
+    if ((uint64_t)trail.size() > units){
+        compactLearnts();
+        int i, j;
+        for (i = j = 0; i < clauses.size(); i++)
+            if (ca[clauses[i]].mark() == 0)
+                clauses[j++] = clauses[i];
+        clauses.shrink(i - j);
+    }
+
+    viv_props = propagations;
+    checkGarbage();
+    return ok;
+}
+
+
+bool Solver::vivifyClause(CRef cr)
+{
+    Clause& c = ca[cr];
+    c.vivified(true);
+    if (satisfied(c)) return true;    // By a unit found earlier in the pass.
+    detachClause(cr, true);
+
+    // Propagation does not allocate clauses (there is no external propagator), so 'c' stays valid:
+    vec<Lit>& lits = add_tmp;
+    lits.clear();
+    for (int i = 0; i < c.size(); i++){
+        Lit p = c[i];
+        if (value(p) == l_False) continue;
+        lits.push(p);
+        if (value(p) == l_True) break;
+        newDecisionLevel();
+        uncheckedEnqueue(~p);
+        if (propagate() != CRef_Undef) break;
+    }
+    cancelUntil(0);
+
+    if (lits.size() == c.size()){
+        attachClause(cr);
+        return true; }
+
+    vivified_clauses++;
+    vivified_lits += c.size() - lits.size();
+    if (proof){
+        proof->addClause(lits);
+        proof->deleteClause(c); }
+
+    if (lits.size() == 1){
+        c.mark(1);
+        ca.free(cr);
+        uncheckedEnqueue(lits[0]);
+        if (propagate() != CRef_Undef){
+            if (proof) proof->addEmptyClause();
+            return ok = false; }
+        return true;
+    }
+
+    for (int i = 0; i < lits.size(); i++)
+        c[i] = lits[i];
+    c.shrink(c.size() - lits.size());
+    if (!c.learnt() && c.has_extra())
+        c.calcAbstraction();
+    attachClause(cr);
+    return true;
+}
+
+
 void Solver::removeSatisfied(vec<CRef>& cs)
 {
     auto i = cs.begin();
@@ -574,6 +1003,42 @@ void Solver::removeSatisfied(vec<CRef>& cs)
 }
 
 
+void Solver::compactLearnts()
+{
+    int i, j;
+    for (i = j = 0; i < learnts.size(); i++){
+        Clause& c = ca[learnts[i]];
+        if (c.mark() == 0){
+            c.slot()        = j;
+            learnts[j]      = learnts[i];
+            learnt_act[j++] = learnt_act[i]; }
+    }
+    learnts.shrink(i - j);
+    learnt_act.shrink(i - j);
+}
+
+
+// Values that would become denormal are flushed to zero instead, as arithmetic on denormals is
+// very slow on most processors:
+void Solver::rescaleActivity(vec<float>& act, float f)
+{
+    float* a   = act;
+    int    n   = act.size();
+    float  lim = FLT_MIN / f;
+    int    i   = 0;
+#if defined(__SSE__) || defined(_M_X64)
+    __m128 vf   = _mm_set1_ps(f);
+    __m128 vlim = _mm_set1_ps(lim);
+    for (; i + 4 <= n; i += 4){
+        __m128 x = _mm_loadu_ps(a + i);
+        x = _mm_and_ps(x, _mm_cmpge_ps(x, vlim));
+        _mm_storeu_ps(a + i, _mm_mul_ps(x, vf)); }
+#endif
+    for (; i < n; i++)
+        a[i] = a[i] >= lim ? a[i] * f : 0;
+}
+
+
 void Solver::rebuildOrderHeap()
 {
     vec<Var> vs;
@@ -594,16 +1059,23 @@ void Solver::rebuildOrderHeap()
 |________________________________________________________________________________________________@*/
 bool Solver::simplify()
 {
-    assert(decisionLevel() == 0);
+    cancelUntil(0);
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_Simplify);
 
-    if (!ok || propagate() != CRef_Undef)
-        return ok = false;
+    if (!ok)
+        return false;
+    else if (propagate() != CRef_Undef){
+        if (proof) proof->addEmptyClause();
+        return ok = false; }
 
     if (nAssigns() == simpDB_assigns || (simpDB_props > 0))
         return true;
 
     // Remove satisfied clauses:
-    removeSatisfied(learnts);
+    for (int i = 0; i < learnts.size(); i++)
+        if (satisfied(ca[learnts[i]]))
+            removeClause(learnts[i]);
+    compactLearnts();
     if (remove_satisfied)        // Can be turned off.
         removeSatisfied(clauses);
     checkGarbage();
@@ -642,17 +1114,23 @@ lbool Solver::search(int nof_conflicts)
         if (confl != CRef_Undef){
             // CONFLICT
             conflicts++; conflictC++;
-            if (decisionLevel() == 0) return l_False;
+            if (stats) stats->tick();
+            if (terminate_callback != NULL && terminate_callback(terminate_state)) asynch_interrupt = true;
+            if (decisionLevel() == 0){
+                if (proof) proof->addEmptyClause();
+                return l_False; }
 
             learnt_clause.clear();
             analyze(confl, learnt_clause, backtrack_level);
             cancelUntil(backtrack_level);
+            if (proof) proof->addClause(learnt_clause);
+            if (learnt_callback != NULL) learnt_callback(learnt_state, learnt_clause);
 
             if (learnt_clause.size() == 1){
                 uncheckedEnqueue(learnt_clause[0]);
             }else{
                 CRef cr = ca.alloc(learnt_clause, true);
-                learnts.push(cr);
+                pushLearnt(cr);
                 attachClause(cr);
                 claBumpActivity(ca[cr]);
                 uncheckedEnqueue(learnt_clause[0], cr);
@@ -679,6 +1157,15 @@ lbool Solver::search(int nof_conflicts)
                 // Reached bound on number of conflicts:
                 progress_estimate = progressEstimate();
                 cancelUntil(0);
+
+                // Synchronize with the other solvers of a parallel run, at the first restart after
+                // 'sync_props' propagations (at the top level, where their clauses can be imported,
+                // and without restarting more often; the points are fixed by the search of this
+                // solver, so a run can be repeated exactly):
+                if (sync_callback != NULL && propagations >= next_sync){
+                    next_sync = propagations + sync_props;
+                    sync_callback(sync_state);
+                    if (!ok) return l_False; }
                 return l_Undef; }
 
             // Simplify the set of problem clauses:
@@ -772,6 +1259,22 @@ lbool Solver::solve_()
     conflict.clear();
     if (!ok) return l_False;
 
+    // The clauses of the open groups are active (see 'push()'):
+    if (group_lits.size() > 0){
+        vec<Lit> user_assumps;
+        assumptions.moveTo(user_assumps);
+        group_lits.copyTo(assumptions);
+        for (int i = 0; i < user_assumps.size(); i++)
+            assumptions.push(user_assumps[i]);
+    }
+
+    // Keep the decision levels of the assumptions shared with the last call:
+    int keep = 0;
+    while (keep < decisionLevel() && keep < assumptions.size() && trail_assumps[keep] == assumptions[keep])
+        keep++;
+    cancelUntil(keep);
+    reused_levels += keep;
+
     solves++;
 
     max_learnts               = nClauses() * learntsize_factor;
@@ -793,6 +1296,9 @@ lbool Solver::solve_()
         status = search(rest_base * restart_first);
         if (!withinBudget()) break;
         curr_restarts++;
+
+        if (status == l_Undef && viv_interval > 0 && curr_restarts % viv_interval == 0 && !vivify())
+            status = l_False;
     }
 
     if (verbosity >= 1)
@@ -805,8 +1311,26 @@ lbool Solver::solve_()
         for (int i = 0; i < nVars(); i++) model[i] = value(i);
     }else if (status == l_False && conflict.size() == 0)
         ok = false;
+    else if (status == l_False && group_lits.size() > 0){
+        // Only report the assumptions of the user (an empty conflict means the open groups are contradictory):
+        int i, j;
+        for (i = j = 0; i < conflict.size(); i++){
+            int g;
+            for (g = 0; g < group_lits.size() && var(group_lits[g]) != var(conflict[i]); g++);
+            if (g == group_lits.size())
+                conflict[j++] = conflict[i]; }
+        conflict.shrink(i - j);
+    }
 
-    cancelUntil(0);
+    // Backtrack to the assumption levels that were completely propagated (only the levels of the
+    // assumptions, as 'search()' makes its own decisions above them), or to the top level:
+    int kept = 0;
+    if (reuse_trail && ok && status != l_Undef)
+        kept = decisionLevel() < assumptions.size() ? decisionLevel() : assumptions.size();
+    cancelUntil(kept);
+    trail_assumps.clear();
+    for (int i = 0; i < kept; i++)
+        trail_assumps.push(assumptions[i]);
     return status;
 }
 
@@ -851,6 +1375,8 @@ void Solver::toDimacs(const char *file, const vec<Lit>& assumps)
 
 void Solver::toDimacs(FILE* f, const vec<Lit>&)
 {
+    cancelUntil(0);
+
     // Handle case when solver is in contradictory state:
     if (!ok){
         fprintf(f, "p cnf 1 2\n1 0\n-1 0\n");
@@ -918,7 +1444,7 @@ void Solver::relocAll(ClauseAllocator& to)
     for (auto const& t : trail) {
         Var v = var(t);
 
-        if (reason(v) != CRef_Undef && (ca[reason(v)].reloced() || locked(ca[reason(v)])))
+        if (reason(v) != CRef_Undef && reason(v) != CRef_Lazy && (ca[reason(v)].reloced() || locked(ca[reason(v)])))
             ca.reloc(vardata[v].reason, to);
     }
 
@@ -938,6 +1464,9 @@ void Solver::relocAll(ClauseAllocator& to)
 
 void Solver::garbageCollect()
 {
+    double start_time = cpuTime();
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_GarbageCollect);
+
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted());
@@ -947,4 +1476,96 @@ void Solver::garbageCollect()
         fprintf(stderr, "|  Garbage collection:   %12d bytes => %12d bytes             |\n",
                ca.size()*ClauseAllocator::Unit_Size, to.size()*ClauseAllocator::Unit_Size);
     to.moveTo(ca);
+
+    garbage_collects++;
+    gc_time += cpuTime() - start_time;
+}
+
+
+void Solver::extractFeatures(InstanceFeatures& f) const
+{
+    vec<int> deg(nVars(), 0);
+    double   units = 0, binaries = 0, neg_binaries = 0, horns = 0, lits = 0;
+    for (int i = 0; i < 7; i++) f.len_hist[i] = 0;
+
+    // Units are on the trail (the parser does not keep them as clauses):
+    for (int i = 0; i < trail.size() && (trail_lim.size() == 0 || i < trail_lim[0]); i++){
+        deg[var(trail[i])]++;
+        units++;
+        horns++; }
+
+    for (int i = 0; i < clauses.size(); i++){
+        const Clause& c = ca[clauses[i]];
+        int           pos = 0;
+        for (int j = 0; j < c.size(); j++){
+            deg[var(c[j])]++;
+            pos += !sign(c[j]); }
+
+        int n = c.size();
+        f.len_hist[n <= 4 ? n - 1 : n <= 8 ? 4 : n <= 16 ? 5 : 6]++;
+        binaries     += n == 2;
+        neg_binaries += n == 2 && pos == 0;
+        horns        += pos <= 1;
+        lits         += n;
+    }
+
+    double total = units + clauses.size();
+    double norm  = total > 0 ? 1 / total : 0;
+    f.vars             = nVars();
+    f.clauses          = total;
+    f.len_mean         = (lits + units) * norm;
+    f.binary_frac      = binaries * norm;
+    f.ternary_frac     = f.len_hist[2] * norm;
+    f.neg_binary_frac  = neg_binaries * norm;
+    f.horn_frac        = horns * norm;
+    f.clause_var_ratio = nVars() > 0 ? total / nVars() : 0;
+
+    double sum = 0, sum_sq = 0, max = 0;
+    for (int v = 0; v < nVars(); v++){
+        sum    += deg[v];
+        sum_sq += (double)deg[v] * deg[v];
+        if (deg[v] > max) max = deg[v]; }
+    f.deg_mean = nVars() > 0 ? sum / nVars() : 0;
+    f.deg_max  = max;
+    f.deg_cv   = f.deg_mean > 0 ? sqrt(sum_sq / nVars() - f.deg_mean * f.deg_mean) / f.deg_mean : 0;
+}
+
+
+void Solver::registerStats(StatsRegistry& reg)
+{
+    reg.add("vars",             [this]{ return (double)nVars(); });
+    reg.add("clauses",          [this]{ return (double)nClauses(); });
+    reg.add("learnts",          [this]{ return (double)nLearnts(); });
+    reg.add("arena_bytes",      [this]{ return (double)nArenaBytes(); });
+    reg.add("solves",           &solves);
+    reg.add("restarts",         &starts);
+    reg.add("decisions",        &decisions);
+    reg.add("rnd_decisions",    &rnd_decisions);
+    reg.add("propagations",     &propagations);
+    reg.add("conflicts",        &conflicts);
+    reg.add("conflict_literals",&tot_literals);
+    reg.add("deleted_literals", [this]{ return (double)(max_literals - tot_literals); });
+    reg.add("reduce_dbs",       &reduce_dbs);
+    reg.add("garbage_collects", &garbage_collects);
+    reg.add("reused_levels",    &reused_levels);
+    reg.add("ext_propagations", &ext_propagations);
+    reg.add("ext_reasons",      &ext_reasons);
+    reg.add("vivified_clauses", &vivified_clauses);
+    reg.add("vivified_lits",    &vivified_lits);
+    reg.add("gc_time",          &gc_time);
+    reg.add("reduce_db_time",   &reduce_time);
+    reg.add("cpu_time",         []{ return cpuTime(); });
+    reg.add("mem_used_peak",    []{ return memUsedPeak(); });
+
+    if (profile.enabled){
+        char name[64];
+        for (int p = 0; p < phase_Count; p++){
+            sprintf(name, "time_%s", phaseName(p));
+            reg.add(name, [this, p]{ return profile.seconds(p); });
+            sprintf(name, "calls_%s", phaseName(p));
+            reg.add(name, [this, p]{ return (double)profile.calls(p); });
+        }
+        for (int c = 0; c < ctr_Count; c++)
+            reg.add(counterName(c), [this, c]{ return (double)profile.counter(c); });
+    }
 }
@@ -25,11 +25,18 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "minisat/mtl/Heap.h"
 #include "minisat/mtl/Alg.h"
 #include "minisat/utils/Options.h"
+#include "minisat/utils/Profile.h"
 #include "minisat/core/SolverTypes.h"
+#include "minisat/core/SolverConfig.h"
+#include "minisat/core/ExternalPropagator.h"
 
 
 namespace Minisat {
 
+class DratWriter;
+class StatsRegistry;
+struct InstanceFeatures;
+
 //=================================================================================================
 // Solver -- the main class:
 
@@ -38,9 +45,12 @@ public:
 
     // Constructor/Destructor:
     //
-    Solver();
+    Solver();                                     // Configured by the command-line options.
+    explicit Solver(const SolverConfig& config);
     virtual ~Solver();
 
+    virtual void setConfig(const SolverConfig& config);  // Set the parameters (as the constructor does).
+
     // Problem specification:
     //
     Var     newVar    (bool polarity = true, bool dvar = true); // Add a new variable with parameters specifying variable mode.
@@ -52,6 +62,19 @@ public:
     bool    addClause (Lit p, Lit q, Lit r);                    // Add a ternary clause to the solver.
     bool    addClause_(      vec<Lit>& ps);                     // Add a clause to the solver without making superflous internal copy. Will
                                                                 // change the passed vector 'ps'.
+    bool    importClause(const vec<Lit>& ps);                   // Add a clause learnt by another solver on the same variables, as a learnt
+                                                                // clause. Only at decision level 0 (as from 'sync_callback').
+
+    // Clause groups (incremental solving):
+    //
+    void    push      ();                                       // Open a new clause group: the clauses added until the matching 'pop()' belong to it.
+    void    pop       ();                                       // Close the innermost group and remove its clauses (and the learnt clauses derived from them).
+    int     nGroups   ()      const;                            // The current number of open groups.
+
+    // External propagator:
+    //
+    void    connectPropagator(ExternalPropagator* p);           // Connect a propagator ('NULL' disconnects it). It is not owned by the solver.
+    void    addObservedVar   (Var v);                           // The propagator is notified of the assignments of 'v' (from the next propagation on).
 
     // Solving:
     //
@@ -81,7 +104,7 @@ public:
 
     // Read state:
     //
-    lbool   value      (Var x) const;       // The current value of a variable.
+    lbool   value      (Var x) const;       // The current value of a variable (includes the assumption levels kept by 'reuse_trail').
     lbool   value      (Lit p) const;       // The current value of a literal.
     lbool   modelValue (Var x) const;       // The value of a variable in the last model. The last call to solve must have been satisfiable.
     lbool   modelValue (Lit p) const;       // The value of a literal in the last model. The last call to solve must have been satisfiable.
@@ -90,6 +113,7 @@ public:
     int     nLearnts   ()      const;       // The current number of learnt clauses.
     int     nVars      ()      const;       // The current number of variables.
     int     nFreeVars  ()      const;
+    uint64_t nArenaBytes()     const;       // Bytes in use by the clause arena (including space not reclaimed yet).
 
     // Resource contraints:
     //
@@ -105,6 +129,11 @@ public:
     void    checkGarbage(double gf);
     void    checkGarbage();
 
+    // Statistics export:
+    //
+    virtual void registerStats(StatsRegistry& reg);  // Add the solver's statistics to 'reg'.
+    void    extractFeatures(InstanceFeatures& f) const;     // Features of the original clauses (for choosing a preset after parsing).
+
     // Extra results: (read-only member variable)
     //
     vec<lbool> model;             // If problem is satisfiable, this vector contains the model (if any).
@@ -124,6 +153,9 @@ public:
     bool      rnd_pol;            // Use random polarities for branching heuristics.
     bool      rnd_init_act;       // Initialize variable activities with a small random value.
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
+    bool      reuse_trail;        // Keep the assumption levels of the trail after 'solve()', for the next call with the same assumption prefix.
+    int       viv_interval;       // Vivify clauses every this many restarts (0 = never).
+    double    viv_effort;         // Propagations of a vivification pass, as a fraction of those of the search since the last one.
 
     int       restart_first;      // The initial restart limit.                                                                (default 100)
     double    restart_inc;        // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
@@ -133,10 +165,35 @@ public:
     int       learntsize_adjust_start_confl;
     double    learntsize_adjust_inc;
 
+    // Proof logging:
+    //
+    DratWriter* proof;            // If set, all learnt and deleted clauses are written as a DRAT proof (default NULL, i.e. off).
+
+    // Statistics export:
+    //
+    StatsRegistry* stats;         // If set, gets a chance to write a periodic record after every conflict (default NULL).
+
+    // Callbacks: (default NULL, i.e. off)
+    //
+    bool    (*terminate_callback)(void* state);                  // Polled after every conflict; 'true' interrupts the search (as 'interrupt()').
+    void*     terminate_state;
+    void    (*learnt_callback)  (void* state, const vec<Lit>& c); // Called with every learnt clause (including units).
+    void*     learnt_state;
+    void    (*sync_callback)    (void* state);                  // Called at the first restart after every 'sync_props' propagations (for
+    void*     sync_state;                                      // a parallel run to exchange clauses through 'importClause()').
+    int64_t   sync_props;
+
     // Statistics: (read-only member variable)
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t reduce_dbs, garbage_collects;
+    uint64_t reused_levels;       // Assumption levels kept from the previous call to 'solve()'.
+    uint64_t ext_propagations, ext_reasons;  // Literals propagated by the external propagator, and reasons asked for.
+    uint64_t vivified_clauses, vivified_lits; // Clauses shortened by 'vivify()', and the literals removed from them.
+    double   gc_time;             // CPU time spent in 'garbageCollect()'.
+    double   reduce_time;         // CPU time spent in 'reduceDB()' (without the garbage collection it triggers).
+    PhaseProfiler<ProfilingPolicy> profile;  // Time per phase and hot-path counters (empty unless built with MINISAT_PROFILE).
 
 protected:
 
@@ -161,9 +218,9 @@ protected:
     };
 
     struct VarOrderLt {
-        const vec<double>&  activity;
+        const vec<float>&   activity;
         bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
-        VarOrderLt(const vec<double>&  act) : activity(act) { }
+        VarOrderLt(const vec<float>&   act) : activity(act) { }
     };
 
     // Solver state:
@@ -171,8 +228,9 @@ protected:
     bool                ok;               // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
     vec<CRef>           clauses;          // List of problem clauses.
     vec<CRef>           learnts;          // List of learnt clauses.
+    vec<float>          learnt_act;       // 'learnt_act[i]' is the activity of 'learnts[i]' (which keeps 'i' as its 'slot()').
     double              cla_inc;          // Amount to bump next clause with.
-    vec<double>         activity;         // A heuristic measurement of the activity of a variable.
+    vec<float>          activity;         // A heuristic measurement of the activity of a variable.
     double              var_inc;          // Amount to bump next variable with.
     OccLists<Lit, vec<Watcher>, WatcherDeleted>
                         watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
@@ -186,9 +244,14 @@ protected:
     int                 simpDB_assigns;   // Number of top-level assignments since last execution of 'simplify()'.
     int64_t             simpDB_props;     // Remaining number of propagations that must be made before next execution of 'simplify()'.
     vec<Lit>            assumptions;      // Current set of assumptions provided to solve by the user.
+    vec<Lit>            group_lits;       // Activation literals of the open clause groups (innermost last).
+    vec<Lit>            trail_assumps;    // The assumptions of the decision levels kept by the last 'solve_()' (see 'reuse_trail').
     Heap<VarOrderLt>    order_heap;       // A priority queue of variables ordered with respect to the variable activity.
     double              progress_estimate;// Set by 'search()'.
     bool                remove_satisfied; // Indicates whether possibly inefficient linear scan for satisfied clauses should be performed in 'simplify'.
+    ExternalPropagator* ext;              // The connected external propagator (NULL if none).
+    vec<char>           observed;         // Variables whose assignments are passed to 'ext'.
+    int                 ext_qhead;        // Head of the queue of assignments not passed to 'ext' yet (index into 'trail').
 
     ClauseAllocator     ca;
 
@@ -199,7 +262,12 @@ protected:
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    vec<Lit>            ext_tmp;
+    vec<float>          reduce_keys;
+    vec<float>          reduce_sel;
 
+    uint64_t            viv_props;        // 'propagations' at the end of the last 'vivify()'.
+    uint64_t            next_sync;        // 'propagations' after which 'sync_callback' is called at the next restart.
     double              max_learnts;
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
@@ -212,12 +280,15 @@ protected:
 
     // Main internal methods:
     //
+    bool     addClauseNoGroup_(vec<Lit>& ps);                                          // As 'addClause_()', but the clause does not belong to the innermost group.
     void     insertVarOrder   (Var x);                                                 // Insert a variable in the decision order priority queue.
     Lit      pickBranchLit    ();                                                      // Return the next decision variable.
     void     newDecisionLevel ();                                                      // Begins a new decision level.
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
+    CRef     propagateClauses ();                                                      // Unit propagation over the clauses only (without the external propagator).
+    CRef     addExternalClause(Lit p);                                                 // Store the reason of 'p' given by the external propagator as a learnt clause.
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
     void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
@@ -225,7 +296,11 @@ protected:
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    bool     vivify           ();                                                      // Shorten the most active learnt clauses by unit propagation.
+    bool     vivifyClause     (CRef cr);                                               // (helper method for 'vivify()')
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
+    void     pushLearnt       (CRef cr);                                               // Add a new clause to 'learnts' (with activity 0).
+    void     compactLearnts   ();                                                      // Drop the removed clauses from 'learnts'.
     void     rebuildOrderHeap ();
 
     // Maintaining Variable/Clause activity:
@@ -235,6 +310,7 @@ protected:
     void     varBumpActivity  (Var v);                 // Increase a variable with the current 'bump' value.
     void     claDecayActivity ();                      // Decay all clauses with the specified factor. Implemented by increasing the 'bump' value instead.
     void     claBumpActivity  (Clause& c);             // Increase a clause with the current 'bump' value.
+    static void rescaleActivity(vec<float>& act, float f); // Multiply all activities by 'f' (SIMD where available).
 
     // Operations on clauses:
     //
@@ -251,6 +327,7 @@ protected:
     int      decisionLevel    ()      const; // Gives the current decisionlevel.
     uint32_t abstractLevel    (Var x) const; // Used to represent an abstraction of sets of decision levels.
     CRef     reason           (Var x) const;
+    CRef     reasonClause     (Var x);       // As 'reason()', but asks the external propagator for a lazy reason ('CRef_Lazy').
     int      level            (Var x) const;
     double   progressEstimate ()      const; // DELETE THIS ?? IT'S NOT VERY USEFUL ...
     bool     withinBudget     ()      const;
@@ -276,6 +353,9 @@ protected:
 
 inline CRef Solver::reason(Var x) const { return vardata[x].reason; }
 inline int  Solver::level (Var x) const { return vardata[x].level; }
+inline CRef Solver::reasonClause(Var x) {
+    if (vardata[x].reason == CRef_Lazy) vardata[x].reason = addExternalClause(value(x) == l_True ? mkLit(x) : ~mkLit(x));
+    return vardata[x].reason; }
 
 inline void Solver::insertVarOrder(Var x) {
     if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x); }
@@ -283,11 +363,10 @@ inline void Solver::insertVarOrder(Var x) {
 inline void Solver::varDecayActivity() { var_inc *= (1 / var_decay); }
 inline void Solver::varBumpActivity(Var v) { varBumpActivity(v, var_inc); }
 inline void Solver::varBumpActivity(Var v, double inc) {
-    if ( (activity[v] += inc) > 1e100 ) {
+    if ( (activity[v] = float(activity[v] + inc)) > 1e30 ) {
         // Rescale:
-        for (int i = 0; i < nVars(); i++)
-            activity[i] *= 1e-100;
-        var_inc *= 1e-100; }
+        rescaleActivity(activity, 1e-30f);
+        var_inc *= 1e-30; }
 
     // Update order_heap with respect to new activity:
     if (order_heap.inHeap(v))
@@ -295,15 +374,19 @@ inline void Solver::varBumpActivity(Var v, double inc) {
 
 inline void Solver::claDecayActivity() { cla_inc *= (1 / clause_decay); }
 inline void Solver::claBumpActivity (Clause& c) {
-    if ( (c.activity() = float(c.activity() + cla_inc)) > 1e20 ) {
+    float& act = learnt_act[c.slot()];
+    if ( (act = float(act + cla_inc)) > 1e20 ) {
         // Rescale:
-        for (auto const& learnt : learnts) {
-            ca[learnt].activity() = float(ca[learnt].activity() * 1e-20);
-        }
+        rescaleActivity(learnt_act, 1e-20f);
         cla_inc *= 1e-20;
     }
 }
 
+inline void Solver::pushLearnt(CRef cr) {
+    ca[cr].slot() = learnts.size();
+    learnts.push(cr);
+    learnt_act.push(0); }
+
 inline void Solver::checkGarbage(void){ return checkGarbage(garbage_frac); }
 inline void Solver::checkGarbage(double gf){
     if (ca.wasted() > ca.size() * gf)
@@ -316,8 +399,8 @@ inline bool     Solver::addEmptyClause  ()                      { add_tmp.clear(
 inline bool     Solver::addClause       (Lit p)                 { add_tmp.clear(); add_tmp.push(p); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q, Lit r)   { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp); }
-inline bool     Solver::locked          (const Clause& c) const { return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && ca.lea(reason(var(c[0]))) == &c; }
-inline void     Solver::newDecisionLevel()                      { trail_lim.push(trail.size()); }
+inline bool     Solver::locked          (const Clause& c) const { return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && reason(var(c[0])) != CRef_Lazy && ca.lea(reason(var(c[0]))) == &c; }
+inline void     Solver::newDecisionLevel()                      { trail_lim.push(trail.size()); if (ext != NULL) ext->notifyNewDecisionLevel(); }
 
 inline int      Solver::decisionLevel ()      const   { return trail_lim.size(); }
 inline uint32_t Solver::abstractLevel (Var x) const   { return 1 << (level(x) & 31); }
@@ -330,6 +413,8 @@ inline int      Solver::nClauses      ()      const   { return clauses.size(); }
 inline int      Solver::nLearnts      ()      const   { return learnts.size(); }
 inline int      Solver::nVars         ()      const   { return vardata.size(); }
 inline int      Solver::nFreeVars     ()      const   { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
+inline int      Solver::nGroups       ()      const   { return group_lits.size(); }
+inline uint64_t Solver::nArenaBytes   ()      const   { return (uint64_t)ca.size() * ClauseAllocator::Unit_Size; }
 inline void     Solver::setPolarity   (Var v, bool b) { polarity[v] = b; }
 inline void     Solver::setDecisionVar(Var v, bool b)
 {
@@ -0,0 +1,117 @@
+/*********************************************************************************[SolverConfig.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <string.h>
+
+#include "minisat/core/SolverConfig.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Defaults (the options of 'Solver.cc' and 'SimpSolver.cc' take theirs from here):
+
+
+SolverConfig::SolverConfig() :
+    var_decay          (0.95)
+  , clause_decay       (0.999)
+  , random_var_freq    (0)
+  , random_seed        (91648253)
+  , ccmin_mode         (2)
+  , phase_saving       (2)
+  , rnd_init_act       (false)
+  , luby_restart       (true)
+  , restart_first      (100)
+  , restart_inc        (2)
+  , garbage_frac       (0.20)
+  , reuse_trail        (true)
+  , viv_interval       (8)
+  , viv_effort         (0.1)
+  , learntsize_factor  ((double)1/(double)3)
+  , learntsize_inc     (1.1)
+
+  , grow               (0)
+  , clause_lim         (20)
+  , subsumption_lim    (1000)
+  , use_fwd_sub        (true)
+  , simp_garbage_frac  (0.5)
+  , use_asymm          (false)
+  , use_rcheck         (false)
+  , use_elim           (true)
+  , use_gates          (true)
+  , use_probe          (true)
+  , probe_props        (3000000)
+  , probe_effort       (4)
+  , probe_threads      (1)
+  , use_bva            (false)
+  , bva_lim            (0)
+  , bva_steps          (1000000000)
+  , elim_threads       (1)
+{}
+
+
+//=================================================================================================
+// Presets:
+//
+// Each changes only what was measured to matter for its kind of instance (wall time of
+// 'minisat_simp', against the defaults). BVA is off by default; on these kinds of instance it costs
+// more than it saves (the 36x36 grid of 'sudoku/': 11.0 s to 20.6 s, the instance with 653k
+// variables below: 4.0 s to 6.5 s), so no preset turns it on.
+//
+//   sudoku       -- no probing, which finds next to nothing on the large encodings of 'sudoku/'
+//                   (the 25x25 grid: 1.5-2.5 s down to 1.4-1.8 s; the 36x36 grid the same within
+//                   noise).
+//   industrial   -- less probing, for large structured instances (an instance with 653k
+//                   variables solved by simplification: 4.4-4.8 s down to 4.0-4.4 s).
+//   unsat-heavy  -- geometric restarts instead of Luby, for instances expected to be
+//                   unsatisfiable (four random 3-SAT instances above the threshold: 30.7 s down
+//                   to 8.8 s).
+//   random       -- geometric restarts growing more slowly, for random k-SAT (four satisfiable
+//                   random 3-SAT instances: 47.3 s down to 17.1 s).
+
+
+static void presetDefault   (SolverConfig&)   {}
+static void presetSudoku    (SolverConfig& c) { c.use_probe = false; }
+static void presetIndustrial(SolverConfig& c) { c.probe_props = 1000000; }
+static void presetUnsatHeavy(SolverConfig& c) { c.luby_restart = false; c.restart_inc = 2; }
+static void presetRandom    (SolverConfig& c) { c.luby_restart = false; c.restart_inc = 1.5; }
+
+static const struct {
+    const char* name;
+    const char* help;
+    void      (*apply)(SolverConfig& c);
+} presets[] = {
+    { "default",     "the defaults of the options",                                 presetDefault    },
+    { "sudoku",      "no probing",                                                  presetSudoku     },
+    { "industrial",  "less probing",                                                presetIndustrial },
+    { "unsat-heavy", "geometric restarts (factor 2)",                               presetUnsatHeavy },
+    { "random",      "geometric restarts (factor 1.5)",                             presetRandom     },
+};
+
+
+bool SolverConfig::applyPreset(const char* name)
+{
+    for (int i = 0; i < nPresets(); i++)
+        if (strcmp(presets[i].name, name) == 0){
+            presets[i].apply(*this);
+            return true; }
+    return false;
+}
+
+
+int         SolverConfig::nPresets  ()      { return (int)(sizeof(presets) / sizeof(presets[0])); }
+const char* SolverConfig::presetName(int i) { return presets[i].name; }
+const char* SolverConfig::presetHelp(int i) { return presets[i].help; }
@@ -0,0 +1,92 @@
+/**********************************************************************************[SolverConfig.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_SolverConfig_h
+#define Minisat_SolverConfig_h
+
+#include "minisat/mtl/IntTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// SolverConfig -- the parameters of a 'Solver' or 'SimpSolver', as a value:
+//
+// The default constructors of the solvers take the command-line options ('readCoreOptions()' and
+// 'readSimpOptions()'); the constructors taking a 'SolverConfig' do not read any global state, so
+// several differently configured solvers can be created in one process, from any thread. A
+// default constructed 'SolverConfig' has the defaults of the options; the presets change some of
+// them for a kind of instance. The parameters can still be changed in the solver afterwards (they
+// are its public members of the same names).
+
+struct SolverConfig {
+    // Core (options of category "CORE"):
+    //
+    double  var_decay;
+    double  clause_decay;
+    double  random_var_freq;
+    double  random_seed;            // Must not be 0 (and a portfolio gives each solver its own).
+    int     ccmin_mode;
+    int     phase_saving;
+    bool    rnd_init_act;
+    bool    luby_restart;
+    int     restart_first;
+    double  restart_inc;
+    double  garbage_frac;
+    bool    reuse_trail;
+    int     viv_interval;
+    double  viv_effort;
+    double  learntsize_factor;      // (not an option)
+    double  learntsize_inc;         // (not an option)
+
+    // Simplification (options of category "SIMP", only read by 'SimpSolver'):
+    //
+    int     grow;
+    int     clause_lim;
+    int     subsumption_lim;
+    bool    use_fwd_sub;
+    double  simp_garbage_frac;
+    bool    use_asymm;
+    bool    use_rcheck;
+    bool    use_elim;
+    bool    use_gates;
+    bool    use_probe;
+    int64_t probe_props;
+    double  probe_effort;
+    int     probe_threads;
+    bool    use_bva;
+    int     bva_lim;
+    int64_t bva_steps;
+    int     elim_threads;
+
+    SolverConfig();                       // The defaults of the options.
+
+    SolverConfig& readCoreOptions();      // Takes the "CORE" options given on the command line (defined in 'Solver.cc').
+    SolverConfig& readSimpOptions();      // Takes the "SIMP" options given on the command line (defined in 'SimpSolver.cc').
+
+    // Presets: applying one changes the parameters it is about and keeps the others. It goes before
+    // the command-line options, so an option given explicitly wins over the preset. Returns FALSE (and
+    // changes nothing) for an unknown name.
+    bool               applyPreset(const char* name);
+    static int         nPresets   ();
+    static const char* presetName (int i);
+    static const char* presetHelp (int i);
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -130,8 +130,11 @@ class Clause {
         unsigned learnt    : 1;
         unsigned has_extra : 1;
         unsigned reloced   : 1;
-        unsigned size      : 27; }                            header;
-    union data_union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
+        unsigned vivified  : 1;
+        unsigned size      : 26; }                            header;
+    union data_union { Lit lit; uint32_t slot; uint32_t abs; CRef rel; } data[0]; // The extra field follows the literals: the
+                                                                                 // slot of a learnt clause (one word) or the
+                                                                                 // abstraction of a problem clause (two).
 
     friend class ClauseAllocator;
 
@@ -142,6 +145,7 @@ class Clause {
         header.learnt    = learnt;
         header.has_extra = use_extra;
         header.reloced   = 0;
+        header.vivified  = 0;
         header.size      = ps.size();
 
         for (int i = 0; i < ps.size(); i++)
@@ -149,27 +153,33 @@ class Clause {
 
         if (header.has_extra){
             if (header.learnt)
-                data[header.size].act = 0;
+                data[header.size].slot = 0;
             else
                 calcAbstraction(); }
     }
 
 public:
     void calcAbstraction() {
-        assert(header.has_extra);
-        uint32_t abstraction = 0;
+        assert(header.has_extra); assert(!header.learnt);
+        uint64_t abstraction = 0;
         for (int i = 0; i < size(); i++)
-            abstraction |= 1 << (var(data[i].lit) & 31);
-        data[header.size].abs = abstraction;  }
+            abstraction |= (uint64_t)1 << (var(data[i].lit) & 63);
+        data[header.size  ].abs = (uint32_t)abstraction;
+        data[header.size+1].abs = (uint32_t)(abstraction >> 32); }
 
+    static int extraSize(bool has_extra, bool learnt) { return has_extra ? (learnt ? 1 : 2) : 0; }
 
     int          size        ()      const   { return header.size; }
-    void         shrink      (int i)         { assert(i <= size()); if (header.has_extra) data[header.size-i] = data[header.size]; header.size -= i; }
+    void         shrink      (int i)         { assert(i <= size());
+                                               for (int k = 0; k < extraSize(header.has_extra, header.learnt); k++) data[header.size-i+k] = data[header.size+k];
+                                               header.size -= i; }
     void         pop         ()              { shrink(1); }
     bool         learnt      ()      const   { return header.learnt; }
     bool         has_extra   ()      const   { return header.has_extra; }
     uint32_t     mark        ()      const   { return header.mark; }
     void         mark        (uint32_t m)    { header.mark = m; }
+    bool         vivified    ()      const   { return header.vivified; }
+    void         vivified    (bool b)        { header.vivified = b; }
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
 
     bool         reloced     ()      const   { return header.reloced; }
@@ -182,8 +192,9 @@ public:
     Lit          operator [] (int i) const   { return data[i].lit; }
     operator const Lit* (void) const         { return (Lit*)data; }
 
-    float&       activity    ()              { assert(header.has_extra); return data[header.size].act; }
-    uint32_t     abstraction () const        { assert(header.has_extra); return data[header.size].abs; }
+    uint32_t&    slot        ()              { assert(header.has_extra); return data[header.size].slot; }
+    uint64_t     abstraction () const        { assert(header.has_extra); assert(!header.learnt);
+                                               return data[header.size].abs | (uint64_t)data[header.size+1].abs << 32; }
 
     Lit          subsumes    (const Clause& other) const;
     void         strengthen  (Lit p);
@@ -195,10 +206,11 @@ public:
 
 
 const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
+const CRef CRef_Lazy  = CRef_Undef - 1;   // Reason of a literal propagated by an external propagator, not asked for yet.
 class ClauseAllocator : public RegionAllocator<uint32_t>
 {
-    static int clauseWord32Size(int size, bool has_extra){
-        return (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra))) / sizeof(uint32_t); }
+    static int clauseWord32Size(int size, bool has_extra, bool learnt){
+        return (sizeof(Clause) + (sizeof(Lit) * (size + Clause::extraSize(has_extra, learnt)))) / sizeof(uint32_t); }
  public:
     bool extra_clause_field;
 
@@ -213,10 +225,9 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
     CRef alloc(const Lits& ps, bool learnt = false)
     {
         assert(sizeof(Lit)      == sizeof(uint32_t));
-        assert(sizeof(float)    == sizeof(uint32_t));
         bool use_extra = learnt | extra_clause_field;
 
-        CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), use_extra));
+        CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), use_extra, learnt));
         new (lea(cid)) Clause(ps, use_extra, learnt);
 
         return cid;
@@ -232,7 +243,7 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
     void free(CRef cid)
     {
         Clause& c = operator[](cid);
-        RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra()));
+        RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra(), c.learnt()));
     }
 
     void reloc(CRef& cr, ClauseAllocator& to)
@@ -247,7 +258,8 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
         // Copy extra data-fields:
         // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
         to[cr].mark(c.mark());
-        if (to[cr].learnt())         to[cr].activity() = c.activity();
+        to[cr].vivified(c.vivified());
+        if (to[cr].learnt())         to[cr].slot() = c.slot();
         else if (to[cr].has_extra()) to[cr].calcAbstraction();
     }
 };
@@ -270,6 +282,7 @@ class OccLists
     void  init      (const Idx& idx){ occs.growTo(toInt(idx)+1); dirty.growTo(toInt(idx)+1, 0); }
     // Vec&  operator[](const Idx& idx){ return occs[toInt(idx)]; }
     Vec&  operator[](const Idx& idx){ return occs[toInt(idx)]; }
+    const Vec& operator[](const Idx& idx) const { return occs[toInt(idx)]; }
     Vec&  lookup    (const Idx& idx){ if (dirty[toInt(idx)]) clean(idx); return occs[toInt(idx)]; }
 
     void  cleanAll  ();
@@ -375,7 +388,7 @@ inline Lit Clause::subsumes(const Clause& other) const
     //if (other.size() < size() || (!learnt() && !other.learnt() && (extra.abst & ~other.extra.abst) != 0))
     assert(!header.learnt);   assert(!other.header.learnt);
     assert(header.has_extra); assert(other.header.has_extra);
-    if (other.header.size < header.size || (data[header.size].abs & ~other.data[other.header.size].abs) != 0)
+    if (other.header.size < header.size || (abstraction() & ~other.abstraction()) != 0)
         return lit_Error;
 
     Lit        ret = lit_Undef;
@@ -0,0 +1,738 @@
+/*********************************************************************************[DratChecker.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <thread>
+
+#include "minisat/mtl/Alg.h"
+#include "minisat/utils/ParseUtils.h"
+#include "minisat/drat/DratChecker.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// DratChecker::Db -- one copy of the clause database, stepped through the proof:
+//
+// Clause marks: bit 0 is set for core clauses, bit 1 for clauses that are not part of the database
+// at the current point of the proof.
+
+
+class DratChecker::Db {
+public:
+    struct Watcher {
+        CRef cref;
+        Lit  blocker;
+        Watcher(CRef cr, Lit p) : cref(cr), blocker(p) {}
+        bool operator==(const Watcher& w) const { return cref == w.cref; }
+        bool operator!=(const Watcher& w) const { return cref != w.cref; }
+    };
+
+    // Watchers are always removed eagerly, so nothing is ever smudged:
+    struct WatcherDeleted {
+        bool operator()(const Watcher&) const { return false; } };
+
+    explicit Db(const DratChecker& dc);
+
+    bool     forward   ();                    // Replay until the root level conflicts.
+    void     undo      (int i);               // Step back over item 'i'.
+    bool     checkLemma(int i);               // Check lemma 'i'; its antecedents go to 'ante'.
+
+    bool     isCore    (CRef cr) const { return ca[cr].mark() & 1; }
+    void     setCore   (CRef cr)       { ca[cr].mark(ca[cr].mark() | 1); }
+
+    int      conflict_item;                   // Item after which the root level conflicts.
+    vec<CRef> cref;                           // Clause of each added (or deleted) item.
+    vec<CRef> ante;                           // Antecedents of checked lemmas.
+    vec<int>  ante_lo, ante_hi;               // Range in 'ante' for each lemma checked in a block.
+    vec<char> result;                         // Outcome for each lemma checked in a block.
+
+    uint64_t  propagations, rat_checks, ignored_deletions, missing_deletions;
+
+private:
+    const DratChecker&  dc;
+    ClauseAllocator     ca;
+    OccLists<Lit, vec<Watcher>, WatcherDeleted>
+                        watches;
+    vec<lbool>          assigns;
+    vec<CRef>           reason;
+    vec<Lit>            trail;
+    vec<int>            trail_at;             // Size of the trail before each item.
+    int                 qhead;                // Next literal to propagate over core clauses.
+    int                 qhead_nc;             // Next literal to propagate over other clauses.
+    vec<char>           seen;
+    vec<char>           lit_mark;
+    vec<vec<CRef> >     table;                // Hash index of the clauses, for deletions.
+    vec<Lit>            tmp;
+
+    lbool    value     (Lit p) const { return assigns[var(p)] ^ sign(p); }
+    void     assign    (Lit p, CRef from) { assigns[var(p)] = lbool(!sign(p)); reason[var(p)] = from; trail.push(p); }
+    void     cancel    (int size);
+    bool     locked    (const Clause& c) const {
+        return c.size() > 0 && value(c[0]) == l_True && reason[var(c[0])] != CRef_Undef && &ca[reason[var(c[0])]] == &c; }
+
+    void     attach    (CRef cr);
+    void     detach    (CRef cr);
+    CRef     insert    (CRef cr);
+    CRef     propagate ();
+    CRef     propagateLit(Lit p, bool core);
+    void     analyze   (CRef confl, Lit p);
+    bool     rup       (const vec<Lit>& c);
+
+    uint64_t hash      (const Lit* c, int size) const;
+    CRef     find      (int i);
+    void     index     (CRef cr);
+    void     unindex   (CRef cr);
+};
+
+
+DratChecker::Db::Db(const DratChecker& dc_) :
+    conflict_item    (-1)
+  , propagations     (0)
+  , rat_checks       (0)
+  , ignored_deletions(0)
+  , missing_deletions(0)
+  , dc               (dc_)
+  , watches          (WatcherDeleted())
+  , qhead            (0)
+  , qhead_nc         (0)
+{
+    for (Var v = 0; v < dc.num_vars; v++){
+        watches.init(mkLit(v, false));
+        watches.init(mkLit(v, true ));
+        assigns.push(l_Undef);
+        reason .push(CRef_Undef);
+        seen   .push(0);
+    }
+    lit_mark.growTo(2 * dc.num_vars, 0);
+
+    int n = 1;
+    while (n < dc.items.size()) n <<= 1;
+    table   .growTo(n);
+    cref    .growTo(dc.items.size(), CRef_Undef);
+    trail_at.growTo(dc.items.size(), 0);
+    ante_lo .growTo(dc.items.size(), 0);
+    ante_hi .growTo(dc.items.size(), 0);
+    result  .growTo(dc.items.size(), 0);
+}
+
+
+//=================================================================================================
+// Clause database:
+
+
+void DratChecker::Db::attach(CRef cr)
+{
+    const Clause& c = ca[cr];
+    assert(c.size() > 1);
+    watches[~c[0]].push(Watcher(cr, c[1]));
+    watches[~c[1]].push(Watcher(cr, c[0]));
+}
+
+
+void DratChecker::Db::detach(CRef cr)
+{
+    const Clause& c = ca[cr];
+    assert(c.size() > 1);
+    remove(watches[~c[0]], Watcher(cr, c[1]));
+    remove(watches[~c[1]], Watcher(cr, c[0]));
+}
+
+
+// Add a clause at the root level. Returns the clause itself if it is falsified.
+CRef DratChecker::Db::insert(CRef cr)
+{
+    Clause& c = ca[cr];
+
+    // Move up to two non-false literals to the front, they become the watches:
+    int k = 0;
+    for (int j = 0; j < c.size() && k < 2; j++)
+        if (value(c[j]) != l_False){
+            Lit t = c[k]; c[k] = c[j]; c[j] = t;
+            k++; }
+
+    if (k == 0)
+        return cr;
+    if (k == 1 && value(c[0]) == l_Undef)
+        assign(c[0], cr);
+    if (c.size() > 1)
+        attach(cr);
+    return CRef_Undef;
+}
+
+
+void DratChecker::Db::cancel(int size)
+{
+    for (int c = trail.size()-1; c >= size; c--){
+        Var x = var(trail[c]);
+        assigns[x] = l_Undef;
+        reason [x] = CRef_Undef; }
+    trail.shrink(trail.size() - size);
+    qhead = qhead_nc = size;
+}
+
+
+//=================================================================================================
+// Hash index:
+
+
+uint64_t DratChecker::Db::hash(const Lit* c, int size) const
+{
+    // Order independent, so that deletions can list the literals in any order:
+    uint64_t h = 0;
+    for (int i = 0; i < size; i++){
+        uint64_t x = (uint64_t)toInt(c[i]) + 1;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        h += x ^ (x >> 31); }
+    return h;
+}
+
+
+void DratChecker::Db::index(CRef cr)
+{
+    const Clause& c = ca[cr];
+    table[hash((const Lit*)c, c.size()) & (table.size()-1)].push(cr);
+}
+
+
+void DratChecker::Db::unindex(CRef cr)
+{
+    const Clause& c = ca[cr];
+    remove(table[hash((const Lit*)c, c.size()) & (table.size()-1)], cr);
+}
+
+
+// Find a clause in the database with the same literals as the deletion 'i':
+CRef DratChecker::Db::find(int i)
+{
+    const Item&      it = dc.items[i];
+    const Lit*       ps = &dc.lits[it.start];
+    const vec<CRef>& bucket = table[hash(ps, it.size) & (table.size()-1)];
+
+    for (int k = 0; k < it.size; k++)
+        lit_mark[toInt(ps[k])] = 1;
+
+    CRef found = CRef_Undef;
+    for (int j = 0; j < bucket.size() && found == CRef_Undef; j++){
+        const Clause& c = ca[bucket[j]];
+        if (c.size() != it.size) continue;
+        int k = 0;
+        while (k < c.size() && lit_mark[toInt(c[k])]) k++;
+        if (k == c.size())
+            found = bucket[j];
+    }
+
+    for (int k = 0; k < it.size; k++)
+        lit_mark[toInt(ps[k])] = 0;
+    return found;
+}
+
+
+//=================================================================================================
+// Propagation and conflict analysis:
+
+
+// Propagate all enqueued facts, core clauses first: the other clauses only get to propagate a
+// literal once the core clauses have nothing left to say.
+CRef DratChecker::Db::propagate()
+{
+    CRef confl = CRef_Undef;
+    while (confl == CRef_Undef){
+        if (qhead < trail.size())
+            confl = propagateLit(trail[qhead++], true);
+        else if (qhead_nc < trail.size())
+            confl = propagateLit(trail[qhead_nc++], false);
+        else
+            break;
+    }
+    return confl;
+}
+
+
+CRef DratChecker::Db::propagateLit(Lit p, bool core)
+{
+    CRef           confl = CRef_Undef;
+    vec<Watcher>&  ws    = watches[p];
+    Watcher        *i, *j, *end;
+    propagations++;
+
+    for (i = j = (Watcher*)ws, end = i + ws.size();  i != end;){
+        Lit blocker = i->blocker;
+        if (value(blocker) == l_True){
+            *j++ = *i++; continue; }
+
+        CRef     cr        = i->cref;
+        Clause&  c         = ca[cr];
+        if (((c.mark() & 1) != 0) != core){
+            *j++ = *i++; continue; }
+
+        // Make sure the false literal is data[1]:
+        Lit      false_lit = ~p;
+        if (c[0] == false_lit)
+            c[0] = c[1], c[1] = false_lit;
+        i++;
+
+        Lit     first = c[0];
+        Watcher w     = Watcher(cr, first);
+        if (first != blocker && value(first) == l_True){
+            *j++ = w; continue; }
+
+        // Look for new watch:
+        for (int k = 2; k < c.size(); k++)
+            if (value(c[k]) != l_False){
+                c[1] = c[k]; c[k] = false_lit;
+                watches[~c[1]].push(w);
+                goto NextClause; }
+
+        // Did not find watch -- clause is unit under assignment:
+        *j++ = w;
+        if (value(first) == l_False){
+            confl = cr;
+            while (i < end)
+                *j++ = *i++;
+        }else
+            assign(first, cr);
+
+    NextClause:;
+    }
+    ws.truncate(j);
+
+    return confl;
+}
+
+
+// Collect the clauses used to derive a conflict, either the clause 'confl' or the literal 'p'
+// being both true and assumed false. Root level reasons are included, as they depend on the
+// point of the proof.
+void DratChecker::Db::analyze(CRef confl, Lit p)
+{
+    int pathC = 0;
+    if (confl != CRef_Undef){
+        const Clause& c = ca[confl];
+        ante.push(confl);
+        for (int k = 0; k < c.size(); k++)
+            if (!seen[var(c[k])]){
+                seen[var(c[k])] = 1;
+                pathC++; }
+    }else{
+        seen[var(p)] = 1;
+        pathC++;
+    }
+
+    for (int t = trail.size()-1; pathC > 0; t--){
+        Var x = var(trail[t]);
+        if (!seen[x]) continue;
+        seen[x] = 0;
+        pathC--;
+
+        CRef r = reason[x];
+        if (r == CRef_Undef) continue;
+        const Clause& c = ca[r];
+        ante.push(r);
+        for (int k = 0; k < c.size(); k++)
+            if (!seen[var(c[k])] && var(c[k]) != x){
+                seen[var(c[k])] = 1;
+                pathC++; }
+    }
+}
+
+
+// Reverse unit propagation: does assigning all literals of 'c' to false lead to a conflict?
+bool DratChecker::Db::rup(const vec<Lit>& c)
+{
+    int root = trail.size();
+
+    for (int k = 0; k < c.size(); k++)
+        if (value(c[k]) == l_True){
+            analyze(CRef_Undef, c[k]);
+            cancel(root);
+            return true;
+        }else if (value(c[k]) == l_Undef)
+            assign(~c[k], CRef_Undef);
+
+    CRef confl = propagate();
+    if (confl != CRef_Undef)
+        analyze(confl, lit_Undef);
+    cancel(root);
+    return confl != CRef_Undef;
+}
+
+
+//=================================================================================================
+// Stepping through the proof:
+
+
+bool DratChecker::Db::forward()
+{
+    for (int i = 0; i < dc.items.size(); i++){
+        const Item& it = dc.items[i];
+        trail_at[i] = trail.size();
+
+        if (it.kind == item_Del){
+            CRef cr = find(i);
+            if (cr == CRef_Undef)
+                missing_deletions++;
+            else if (locked(ca[cr]))
+                ignored_deletions++;
+            else{
+                Clause& c = ca[cr];
+                if (c.size() > 1) detach(cr);
+                unindex(cr);
+                c.mark(c.mark() | 2);
+                cref[i] = cr;
+            }
+            continue;
+        }
+
+        tmp.clear();
+        for (int k = 0; k < it.size; k++)
+            tmp.push(dc.lits[it.start + k]);
+        CRef cr = ca.alloc(tmp);
+        cref[i] = cr;
+        index(cr);
+
+        CRef confl = insert(cr);
+        if (confl == CRef_Undef)
+            confl = propagate();
+        if (confl != CRef_Undef){
+            conflict_item = i;
+            analyze(confl, lit_Undef);
+            for (int k = 0; k < ante.size(); k++)
+                setCore(ante[k]);
+            ante.clear();
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void DratChecker::Db::undo(int i)
+{
+    CRef cr = cref[i];
+    if (cr == CRef_Undef) return;
+    Clause& c = ca[cr];
+
+    if (dc.items[i].kind == item_Del){
+        c.mark(c.mark() & 1);
+        if (c.size() > 1) attach(cr);
+    }else{
+        cancel(trail_at[i]);
+        c.mark(c.mark() | 2);
+        if (c.size() > 1) detach(cr);
+    }
+}
+
+
+bool DratChecker::Db::checkLemma(int i)
+{
+    const Item& it = dc.items[i];
+    tmp.clear();
+    for (int k = 0; k < it.size; k++)
+        tmp.push(dc.lits[it.start + k]);
+
+    int lo = ante.size();
+    if (rup(tmp))
+        return true;
+    ante.shrink(ante.size() - lo);
+    if (it.size == 0)
+        return false;
+
+    // RAT on the first literal: every resolvent with a clause containing its negation must be RUP.
+    rat_checks++;
+    Lit pivot = tmp[0];
+    int size  = tmp.size();
+    for (int j = 0; j < i; j++){
+        if (dc.items[j].kind == item_Del || cref[j] == CRef_Undef) continue;
+        const Clause& d = ca[cref[j]];
+        if (d.mark() & 2) continue;
+
+        int k = 0;
+        while (k < d.size() && d[k] != ~pivot) k++;
+        if (k == d.size()) continue;
+
+        tmp.shrink(tmp.size() - size);
+        for (k = 0; k < d.size(); k++)
+            if (d[k] != ~pivot)
+                tmp.push(d[k]);
+        if (!rup(tmp)){
+            ante.shrink(ante.size() - lo);
+            return false; }
+        ante.push(cref[j]);
+    }
+    return true;
+}
+
+
+//=================================================================================================
+// DratChecker:
+
+
+DratChecker::DratChecker() :
+    verbosity        (0)
+  , block_size       (256)
+  , lemmas           (0)
+  , deletions        (0)
+  , ignored_deletions(0)
+  , missing_deletions(0)
+  , core_lemmas      (0)
+  , core_clauses     (0)
+  , checked          (0)
+  , rat_checks       (0)
+  , propagations     (0)
+  , num_vars         (0)
+  , num_orig         (0)
+{}
+
+
+DratChecker::~DratChecker()
+{
+}
+
+
+Var DratChecker::newVar()
+{
+    seen.push(0);
+    seen.push(0);
+    return num_vars++;
+}
+
+
+void DratChecker::addItem(vec<Lit>& ps, int kind)
+{
+    // Remove duplicate literals, but keep the order (the first literal is the RAT pivot):
+    int i, j;
+    for (i = j = 0; i < ps.size(); i++)
+        if (!seen[toInt(ps[i])]){
+            seen[toInt(ps[i])] = 1;
+            ps[j++] = ps[i]; }
+    ps.shrink(i - j);
+    for (i = 0; i < ps.size(); i++)
+        seen[toInt(ps[i])] = 0;
+
+    Item it;
+    it.start = lits.size();
+    it.size  = ps.size();
+    it.kind  = kind;
+    items.push(it);
+    for (i = 0; i < ps.size(); i++)
+        lits.push(ps[i]);
+}
+
+
+bool DratChecker::addClause_(vec<Lit>& ps)
+{
+    assert(num_orig == items.size());
+    addItem(ps, item_Orig);
+    num_orig++;
+    return true;
+}
+
+
+void DratChecker::parseProof(FILE* in)
+{
+    vec<unsigned char> buf;
+    unsigned char      chunk[65536];
+    size_t             n;
+    while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0)
+        for (size_t k = 0; k < n; k++)
+            buf.push(chunk[k]);
+    buf.push(0);
+
+    // The text format only uses digits, '-', 'd', 'c' and white space; anything else (in particular
+    // the zero byte that ends every binary clause) means binary:
+    bool binary = false;
+    for (int k = 0; k < buf.size()-1 && k < 256 && !binary; k++){
+        int ch = buf[k];
+        binary = !((ch >= '0' && ch <= '9') || ch == '-' || ch == 'd' || ch == 'c' || (ch >= 9 && ch <= 13) || ch == 32);
+    }
+    if (verbosity > 0)
+        fprintf(stderr, "c Reading %s proof of %d bytes\n", binary ? "binary" : "text", buf.size()-1);
+
+    vec<Lit> ps;
+    if (binary){
+        int pos = 0, end = buf.size()-1;
+        while (pos < end){
+            int kind = buf[pos++];
+            if (kind != 'a' && kind != 'd')
+                fprintf(stderr, "PARSE ERROR! Unexpected byte in binary proof: %d\n", kind), exit(3);
+            ps.clear();
+            for (;;){
+                uint32_t u = 0;
+                int      shift = 0;
+                while (pos < end && (buf[pos] & 128)){
+                    u |= (uint32_t)(buf[pos++] & 127) << shift;
+                    shift += 7; }
+                if (pos >= end)
+                    fprintf(stderr, "PARSE ERROR! Unexpected end of binary proof.\n"), exit(3);
+                u |= (uint32_t)buf[pos++] << shift;
+                if (u == 0) break;
+                Var v = (Var)(u >> 1) - 1;
+                while (v >= nVars()) newVar();
+                ps.push(mkLit(v, u & 1));
+            }
+            if (kind == 'd') deletions++; else lemmas++;
+            addItem(ps, kind == 'd' ? item_Del : item_Add);
+        }
+    }else{
+        const char* p = (const char*)(unsigned char*)buf;
+        for (;;){
+            skipWhitespace(p);
+            if (*p == '\0') break;
+            if (*p == 'c'){ skipLine(p); continue; }
+            bool del = *p == 'd';
+            if (del) ++p;
+            ps.clear();
+            for (;;){
+                int parsed_lit = parseInt(p);
+                if (parsed_lit == 0) break;
+                Var v = abs(parsed_lit)-1;
+                while (v >= nVars()) newVar();
+                ps.push(mkLit(v, parsed_lit < 0));
+            }
+            if (del) deletions++; else lemmas++;
+            addItem(ps, del ? item_Del : item_Add);
+        }
+    }
+}
+
+
+void DratChecker::printLemma(int i) const
+{
+    const Item& it = items[i];
+    fprintf(stderr, "c Failed lemma %d:", i - num_orig + 1);
+    for (int k = 0; k < it.size; k++)
+        fprintf(stderr, " %s%d", sign(lits[it.start + k]) ? "-" : "", var(lits[it.start + k])+1);
+    fprintf(stderr, " 0\n");
+}
+
+
+bool DratChecker::checkSequential(Db& db, int top)
+{
+    for (int i = top; i >= num_orig; i--){
+        db.undo(i);
+        if (items[i].kind != item_Add || !db.isCore(db.cref[i])) continue;
+
+        core_lemmas++;
+        checked++;
+        if (!db.checkLemma(i)){
+            printLemma(i);
+            return false; }
+        for (int k = 0; k < db.ante.size(); k++)
+            db.setCore(db.ante[k]);
+        db.ante.clear();
+    }
+    return true;
+}
+
+
+bool DratChecker::checkParallel(vec<Db*>& dbs, int top)
+{
+    int nthreads = dbs.size();
+    owner.growTo(items.size(), -1);
+
+    for (int hi = top; hi >= num_orig; ){
+        // Deal out the next block of lemmas:
+        int lo = hi, n = 0;
+        for (; lo >= num_orig && n < block_size * nthreads; lo--)
+            if (items[lo].kind == item_Add)
+                owner[lo] = n++ % nthreads;
+        lo++;
+
+        vec<std::thread*> threads;
+        for (int t = 0; t < nthreads; t++)
+            threads.push(new std::thread([this, &dbs, t, lo, hi]{
+                Db& db = *dbs[t];
+                for (int i = hi; i >= lo; i--){
+                    db.undo(i);
+                    if (items[i].kind != item_Add || owner[i] != t) continue;
+                    db.ante_lo[i] = db.ante.size();
+                    db.result [i] = db.checkLemma(i);
+                    db.ante_hi[i] = db.ante.size();
+                } }));
+        for (int t = 0; t < nthreads; t++){
+            threads[t]->join();
+            delete threads[t]; }
+        checked += n;
+
+        // Merge in proof order, so that a lemma becomes core before its own check is looked at:
+        for (int i = hi; i >= lo; i--){
+            if (items[i].kind != item_Add || !dbs[0]->isCore(dbs[0]->cref[i])) continue;
+
+            const Db& db = *dbs[owner[i]];
+            core_lemmas++;
+            if (!db.result[i]){
+                printLemma(i);
+                return false; }
+            for (int k = db.ante_lo[i]; k < db.ante_hi[i]; k++)
+                for (int t = 0; t < nthreads; t++)
+                    dbs[t]->setCore(db.ante[k]);
+        }
+        for (int t = 0; t < nthreads; t++)
+            dbs[t]->ante.clear();
+
+        hi = lo - 1;
+    }
+    return true;
+}
+
+
+bool DratChecker::check(int nthreads)
+{
+    if (nthreads < 1) nthreads = 1;
+
+    vec<Db*> dbs;
+    for (int t = 0; t < nthreads; t++)
+        dbs.push(new Db(*this));
+
+    // Every copy replays the proof on its own; they all end up in the same state:
+    if (nthreads == 1)
+        dbs[0]->forward();
+    else{
+        vec<std::thread*> threads;
+        for (int t = 0; t < nthreads; t++)
+            threads.push(new std::thread([&dbs, t]{ dbs[t]->forward(); }));
+        for (int t = 0; t < nthreads; t++){
+            threads[t]->join();
+            delete threads[t]; }
+    }
+
+    Db&  db  = *dbs[0];
+    bool ok  = db.conflict_item >= 0;
+    if (!ok)
+        fprintf(stderr, "c No conflict at the root level after the last lemma.\n");
+    else if (verbosity > 0)
+        fprintf(stderr, "c Conflict at the root level after %s %d\n",
+                db.conflict_item < num_orig ? "clause" : "lemma",
+                db.conflict_item < num_orig ? db.conflict_item + 1 : db.conflict_item - num_orig + 1);
+
+    if (ok)
+        ok = nthreads == 1 ? checkSequential(db, db.conflict_item) : checkParallel(dbs, db.conflict_item);
+
+    if (ok)
+        for (int i = 0; i < num_orig; i++)
+            if (db.cref[i] != CRef_Undef && db.isCore(db.cref[i]))
+                core_clauses++;
+
+    ignored_deletions = db.ignored_deletions;
+    missing_deletions = db.missing_deletions;
+    for (int t = 0; t < nthreads; t++){
+        propagations += dbs[t]->propagations;
+        rat_checks   += dbs[t]->rat_checks;
+        delete dbs[t]; }
+
+    return ok;
+}
@@ -0,0 +1,99 @@
+/**********************************************************************************[DratChecker.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_DratChecker_h
+#define Minisat_DratChecker_h
+
+#include <stdio.h>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// DratChecker -- backward checker for DRAT proofs of unsatisfiability:
+//
+// The formula and the proof are first replayed forwards until unit propagation at the root level
+// runs into a conflict. The proof is then walked backwards, and only the lemmas that took part in
+// deriving that conflict (the "core") are checked, by reverse unit propagation or else by the RAT
+// property on their first literal. Propagation visits core clauses before the others, so that
+// checks tend to reuse antecedents that are already in the core. Deletions of clauses that are the
+// reason for a root level assignment are ignored, as in 'drat-trim'.
+//
+// With more than one thread, every thread replays the proof on its own copy of the clause
+// database. The lemmas are then checked in blocks: within a block every lemma is checked, core or
+// not, and the results of the lemmas that turn out to be in the core are merged afterwards in
+// proof order. This trades some extra checks for wall-clock time, and the result does not depend
+// on thread timing.
+
+class DratChecker {
+public:
+    DratChecker();
+    ~DratChecker();
+
+    // Problem specification (the interface expected by 'parse_DIMACS()'):
+    //
+    Var     newVar    ();
+    int     nVars     () const { return num_vars; }
+    bool    addClause_(vec<Lit>& ps);
+
+    // Proof: reads the text or the binary DRAT format (detected automatically):
+    //
+    void    parseProof(FILE* in);
+
+    // Checking:
+    //
+    bool    check     (int threads = 1);  // True if the proof refutes the formula.
+
+    // Mode of operation:
+    //
+    int     verbosity;
+    int     block_size;                   // Lemmas per thread in each block of parallel checking.
+
+    // Statistics:
+    //
+    uint64_t lemmas, deletions, ignored_deletions, missing_deletions;
+    uint64_t core_lemmas, core_clauses, checked, rat_checks, propagations;
+
+protected:
+    class Db;
+
+    enum { item_Orig, item_Add, item_Del };
+    struct Item {
+        uint32_t start;                   // Position of the first literal in 'lits'.
+        int      size;
+        int      kind;
+    };
+
+    int         num_vars;
+    int         num_orig;                 // Number of original clauses; proof items follow them.
+    vec<Item>   items;                    // Original clauses followed by the proof, in order.
+    vec<Lit>    lits;                     // Literals of all items.
+    vec<char>   seen;                     // For removing duplicate literals (indexed by literal).
+    vec<int>    owner;                    // Thread checking each lemma of the current block.
+
+    void    addItem   (vec<Lit>& ps, int kind);
+    void    printLemma(int i) const;
+    bool    checkSequential(Db& db, int top);
+    bool    checkParallel  (vec<Db*>& dbs, int top);
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,108 @@
+/***********************************************************************************[Main_drat.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <errno.h>
+
+#include "minisat/utils/System.h"
+#include "minisat/utils/ParseUtils.h"
+#include "minisat/utils/Options.h"
+#include "minisat/core/Dimacs.h"
+#include "minisat/drat/DratChecker.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+
+//MM: modifications to original minisat source code
+namespace drat {
+
+void printStats(DratChecker& checker, double parse_time, double check_time)
+{
+#   ifndef __MINGW32__
+    double mem_used = memUsedPeak();
+#   endif
+
+    fprintf(stderr, "lemmas                : %-12" PRIu64 "   (%" PRIu64 " in core, %" PRIu64 " checked, %" PRIu64 " RAT)\n", checker.lemmas, checker.core_lemmas, checker.checked, checker.rat_checks);
+    fprintf(stderr, "deletions             : %-12" PRIu64 "   (%" PRIu64 " ignored, %" PRIu64 " not found)\n", checker.deletions, checker.ignored_deletions, checker.missing_deletions);
+    fprintf(stderr, "core clauses          : %" PRIu64 "\n", checker.core_clauses);
+    fprintf(stderr, "propagations          : %-12" PRIu64 "   (%.0f /sec)\n", checker.propagations, checker.propagations/check_time);
+#   ifndef __MINGW32__
+    if (mem_used != 0) fprintf(stderr, "Memory used           : %.2f MB\n", mem_used);
+#   endif
+    fprintf(stderr, "Parse time            : %g s\n", parse_time);
+    fprintf(stderr, "Check time            : %g s\n", check_time);
+}
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    try {
+        setUsageHelp("USAGE: %s [options] <input-file> <proof-file>\n\n  where input is a file containing plain DIMACS and proof a DRAT proof (text or binary).\n");
+
+        // Extra options:
+        //
+        IntOption    verb   ("MAIN", "verb",    "Verbosity level (0=silent, 1=some).", 1, IntRange(0, 1));
+        IntOption    threads("MAIN", "threads", "Number of threads checking lemmas.", 1, IntRange(1, 64));
+        IntOption    block  ("MAIN", "block",   "Lemmas per thread in each block of parallel checking.", 256, IntRange(1, INT32_MAX));
+
+        parseOptions(argc, argv, true);
+
+        if (argc < 3)
+            printUsageAndExit(argc, argv);
+
+        DratChecker C;
+        double      initial_time = realTime();
+        C.verbosity  = verb;
+        C.block_size = block;
+
+		//MM: modifications to original minisat source code
+        FILE* in = NULL;
+        fopen_s(&in, argv[1], "rb");
+        if (in == NULL)
+            fprintf(stderr, "ERROR! Could not open file: %s\n", argv[1]), exit(1);
+        parse_DIMACS(in, C);
+        fclose(in);
+
+        FILE* proof = NULL;
+        fopen_s(&proof, argv[2], "rb");
+        if (proof == NULL)
+            fprintf(stderr, "ERROR! Could not open file: %s\n", argv[2]), exit(1);
+        C.parseProof(proof);
+        fclose(proof);
+
+        double parsed_time = realTime();
+        bool   ok          = C.check(threads);
+        double checked_time = realTime();
+
+        if (C.verbosity > 0)
+            printStats(C, parsed_time - initial_time, checked_time - parsed_time);
+        printf(ok ? "VERIFIED\n" : "NOT VERIFIED\n");
+
+        exit(ok ? 0 : 1);
+    } catch (OutOfMemoryException&){
+        fprintf(stderr, "===============================================================================\n");
+        fprintf(stderr, "INDETERMINATE\n");
+        exit(0);
+    }
+}
+
+//MM: modifications to original minisat source code
+} //namespace drat
@@ -0,0 +1,163 @@
+/**********************************************************************************[IpasirSolver.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdlib.h>
+
+#include "minisat/ipasir/ipasir.h"
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// IPASIR on top of 'Solver', or of 'SimpSolver' when built with MINISAT_IPASIR_SIMP. In the latter
+// case every variable is frozen when it is created, since any of them may be used again by a later
+// call: elimination never removes a variable of the user, but subsumption and self-subsuming
+// resolution still run.
+
+namespace {
+
+#ifdef MINISAT_IPASIR_SIMP
+typedef SimpSolver IpasirBase;
+#else
+typedef Solver     IpasirBase;
+#endif
+
+class IpasirSolver {
+    IpasirBase S;
+    vec<Lit>   clause;            // The clause being added.
+    vec<Lit>   assumps;           // The assumptions of the next call to 'solve()'.
+    vec<char>  failed;            // Indexed by literal: its negation is in the final conflict of the last call.
+    vec<Lit>   failed_lits;       // The literals marked in 'failed'.
+
+    int      (*terminate)(void* state);
+    void*      terminate_state;
+    void     (*learn)(void* state, int* clause);
+    void*      learn_state;
+    int        learn_max;
+    vec<int>   learn_buf;
+
+    static bool terminateCallback(void* self) {
+        IpasirSolver* s = (IpasirSolver*)self;
+        return s->terminate(s->terminate_state) != 0; }
+
+    static void learntCallback(void* self, const vec<Lit>& c) {
+        IpasirSolver* s = (IpasirSolver*)self;
+        if (c.size() > s->learn_max) return;
+        s->learn_buf.clear();
+        for (int i = 0; i < c.size(); i++)
+            s->learn_buf.push(sign(c[i]) ? -(var(c[i]) + 1) : var(c[i]) + 1);
+        s->learn_buf.push(0);
+        s->learn(s->learn_state, (int*)s->learn_buf); }
+
+public:
+    IpasirSolver() : terminate(NULL), terminate_state(NULL), learn(NULL), learn_state(NULL), learn_max(0) {}
+
+    Lit  import(int lit) {
+        Var v = abs(lit) - 1;
+        while (S.nVars() <= v){
+            Var x = S.newVar();
+#ifdef MINISAT_IPASIR_SIMP
+            S.setFrozen(x, true);
+#endif
+            failed.push(0);
+            failed.push(0);
+            (void)x;
+        }
+        return mkLit(v, lit < 0); }
+
+    void add(int lit) {
+        if (lit != 0)
+            clause.push(import(lit));
+        else{
+            S.addClause_(clause);
+            clause.clear(); } }
+
+    void assume(int lit) { assumps.push(import(lit)); }
+
+    int  solve() {
+        for (int i = 0; i < failed_lits.size(); i++)
+            failed[toInt(failed_lits[i])] = 0;
+        failed_lits.clear();
+
+        S.clearInterrupt();
+        lbool ret = S.solveLimited(assumps);
+        assumps.clear();
+
+        if (ret == l_False)
+            for (int i = 0; i < S.conflict.size(); i++){
+                Lit p = ~S.conflict[i];
+                if (!failed[toInt(p)]){
+                    failed[toInt(p)] = 1;
+                    failed_lits.push(p); } }
+        return ret == l_True ? 10 : ret == l_False ? 20 : 0; }
+
+    int  val(int lit) {
+        Var v = abs(lit) - 1;
+        lbool x = v < S.model.size() ? S.model[v] : l_Undef;
+        if (x == l_Undef) return 0;
+        return (x == l_True) == (lit > 0) ? lit : -lit; }
+
+    int  isFailed(int lit) {
+        Var v = abs(lit) - 1;
+        return v < S.nVars() && failed[toInt(mkLit(v, lit < 0))]; }
+
+    void setTerminate(void* state, int (*cb)(void*)) {
+        terminate = cb; terminate_state = state;
+        S.terminate_callback = cb != NULL ? terminateCallback : NULL;
+        S.terminate_state    = this; }
+
+    void setLearn(void* state, int max_length, void (*cb)(void*, int*)) {
+        learn = cb; learn_state = state; learn_max = max_length;
+        S.learnt_callback = cb != NULL ? learntCallback : NULL;
+        S.learnt_state    = this; }
+};
+
+}
+
+
+//=================================================================================================
+// The C interface:
+
+
+extern "C" {
+
+const char* ipasir_signature() { return "minisat-2.2 (MM_SAT_Solver)"; }
+
+void* ipasir_init   ()                    { return new IpasirSolver(); }
+void  ipasir_release(void* solver)        { delete (IpasirSolver*)solver; }
+void  ipasir_add    (void* solver, int l) { ((IpasirSolver*)solver)->add(l); }
+void  ipasir_assume (void* solver, int l) { ((IpasirSolver*)solver)->assume(l); }
+int   ipasir_val    (void* solver, int l) { return ((IpasirSolver*)solver)->val(l); }
+int   ipasir_failed (void* solver, int l) { return ((IpasirSolver*)solver)->isFailed(l); }
+
+int ipasir_solve(void* solver)
+{
+    try {
+        return ((IpasirSolver*)solver)->solve();
+    } catch (OutOfMemoryException&){
+        return 0;
+    }
+}
+
+void ipasir_set_terminate(void* solver, void* state, int (*terminate)(void* state)) {
+    ((IpasirSolver*)solver)->setTerminate(state, terminate); }
+
+void ipasir_set_learn(void* solver, void* state, int max_length, void (*learn)(void* state, int* clause)) {
+    ((IpasirSolver*)solver)->setLearn(state, max_length, learn); }
+
+}
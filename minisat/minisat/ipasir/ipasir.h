@@ -0,0 +1,61 @@
+/****************************************************************************************[ipasir.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_ipasir_h
+#define Minisat_ipasir_h
+
+//=================================================================================================
+// IPASIR -- the standard C interface of incremental SAT solvers (as used by the SAT competitions):
+//
+// Literals are DIMACS integers (a variable 'v' >= 1, or its negation '-v'). Clauses are added with
+// 'ipasir_add()' one literal at a time and closed with 0; assumptions given by 'ipasir_assume()'
+// hold for the next call to 'ipasir_solve()' only. 'ipasir_solve()' returns 10 (satisfiable), 20
+// (unsatisfiable) or 0 (interrupted by the terminate callback). After 10, 'ipasir_val()' gives the
+// model; after 20, 'ipasir_failed()' tells which assumptions were used to show unsatisfiability.
+
+#if defined(_WIN32)
+  #if defined(MINISAT_IPASIR_EXPORTS)
+    #define IPASIR_API __declspec(dllexport)
+  #else
+    #define IPASIR_API
+  #endif
+#elif defined(__GNUC__)
+  #define IPASIR_API __attribute__((visibility("default")))
+#else
+  #define IPASIR_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+IPASIR_API const char* ipasir_signature ();
+IPASIR_API void*       ipasir_init      ();
+IPASIR_API void        ipasir_release   (void* solver);
+IPASIR_API void        ipasir_add       (void* solver, int lit_or_zero);
+IPASIR_API void        ipasir_assume    (void* solver, int lit);
+IPASIR_API int         ipasir_solve     (void* solver);
+IPASIR_API int         ipasir_val       (void* solver, int lit);
+IPASIR_API int         ipasir_failed    (void* solver, int lit);
+IPASIR_API void        ipasir_set_terminate(void* solver, void* state, int (*terminate)(void* state));
+IPASIR_API void        ipasir_set_learn (void* solver, void* state, int max_length, void (*learn)(void* state, int* clause));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
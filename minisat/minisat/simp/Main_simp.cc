@@ -27,6 +27,9 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "minisat/utils/Options.h"
 #include "minisat/core/Dimacs.h"
 #include "minisat/simp/SimpSolver.h"
+#include "minisat/core/DratWriter.h"
+#include "minisat/utils/Stats.h"
+#include "minisat/core/Features.h"
 
 using namespace Minisat;
 
@@ -55,13 +58,38 @@ void printStats(Solver& solver)
     fprintf(stderr, "decisions             : %-12" PRIu64 "   (%4.2f %% random) (%.0f /sec)\n", solver.decisions, (float)solver.rnd_decisions*100 / (float)solver.decisions, solver.decisions   /cpu_time);
     fprintf(stderr, "propagations          : %-12" PRIu64 "   (%.0f /sec)\n", solver.propagations, solver.propagations/cpu_time);
     fprintf(stderr, "conflict literals     : %-12" PRIu64 "   (%4.2f %% deleted)\n", solver.tot_literals, (solver.max_literals - solver.tot_literals)*100 / (double)solver.max_literals);
+    if (solver.reduce_dbs > 0)
+        fprintf(stderr, "reduceDB              : %-12" PRIu64 "   (%.3f ms/call)\n", solver.reduce_dbs, solver.reduce_time*1000 / solver.reduce_dbs);
 #   ifndef __MINGW32__
     if (mem_used != 0) fprintf(stderr, "Memory used           : %.2f MB\n", mem_used);
 #   endif
+    if (solver.proof != NULL)
+        fprintf(stderr, "proof                 : %-12" PRIu64 "   (%" PRIu64 " deleted, %.2f MB)\n", solver.proof->added(), solver.proof->deleted(), solver.proof->bytes() / (1024.0*1024.0));
+    solver.profile.print(stderr);
     fprintf(stderr, "CPU time              : %g s\n", cpu_time);
 }
 
 
+// Write out what is left of the proof before leaving through 'exit()' (which skips destructors):
+static void closeProof(Solver& solver)
+{
+    if (solver.proof != NULL){
+        solver.proof->close();
+        delete solver.proof;
+        solver.proof = NULL; }
+}
+
+
+// Write the final statistics record before leaving through 'exit()':
+static void closeStats(StatsRegistry& stats, FILE* stats_file, int status)
+{
+    if (stats_file != NULL){
+        stats.set("status", status);
+        stats.write("final");
+        fclose(stats_file); }
+}
+
+
 static Solver* solver;
 #if !(defined(__MINGW32__) || defined(_MSC_VER))
 // Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
@@ -101,12 +129,48 @@ int main(int argc, char** argv)
         StringOption dimacs ("MAIN", "dimacs", "If given, stop after preprocessing and write the result to this file.");
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        StringOption drat   ("MAIN", "drat",   "If given, write a DRAT proof of unsatisfiability to this file.");
+        BoolOption   drat_bin("MAIN", "drat-binary", "Use the binary DRAT encoding for the proof.", true);
+        StringOption stats_name("MAIN", "stats", "If given, write machine readable statistics to this file at exit.");
+        StringOption stats_fmt ("MAIN", "stats-format", "Format of the statistics file (json or csv).", "json");
+        DoubleOption stats_int ("MAIN", "stats-interval", "Seconds between statistics records while solving (0 = only at exit).", 0, DoubleRange(0, true, HUGE_VAL, false));
+        StringOption preset    ("MAIN", "preset", "Parameters for a kind of instance, under the options given explicitly (auto, default, sudoku, industrial, unsat-heavy, random).", "auto");
 
         parseOptions(argc, argv, true);
 
-        SimpSolver  S;
+        SolverConfig config;
+        bool auto_preset = strcmp(preset, "auto") == 0;   // Selected from the features of the problem, after parsing.
+        if (!auto_preset && !config.applyPreset(preset))
+            fprintf(stderr, "ERROR! Unknown preset: %s\n", (const char*)preset), exit(1);
+        config.readCoreOptions().readSimpOptions();
+
+        SimpSolver  S(config);
         double      initial_time = cpuTime();
 
+		//MM: modifications to original minisat source code
+        FILE* proof_file = NULL;
+        if (drat){
+            fopen_s(&proof_file, drat, "wb");
+            if (proof_file == NULL)
+                fprintf(stderr, "ERROR! Could not open proof file: %s\n", (const char*)drat), exit(1);
+            S.proof = new DratWriter(proof_file, drat_bin); }
+
+        InstanceFeatures features;
+        StatsRegistry    stats;
+        FILE*            stats_file = NULL;
+        if (stats_name){
+            fopen_s(&stats_file, stats_name, "wb");
+            if (stats_file == NULL)
+                fprintf(stderr, "ERROR! Could not open statistics file: %s\n", (const char*)stats_name), exit(1);
+            S.registerStats(stats);
+            features.registerStats(stats);
+            stats.set("parse_time", 0);
+            stats.set("simplify_time", 0);
+            stats.set("solve_time", 0);
+            stats.set("status", 0);
+            stats.open(stats_file, strcmp(stats_fmt, "csv") == 0 ? StatsRegistry::fmt_CSV : StatsRegistry::fmt_JSON, stats_int);
+            S.stats = &stats; }
+
         if (!pre) S.eliminate(true);
 
         S.verbosity = verb;
@@ -146,7 +210,9 @@ int main(int argc, char** argv)
 		//MM: modifications to original minisat source code
         //FILE* in = (argc == 1) ? fdopen(0, "rb") : fopen(argv[1], "rb");
 		FILE* in = NULL;
-		if(argc == 1)
+		if (argc == 1)
+			in = stdin;
+		else
 			fopen_s(&in, argv[1], "rb");
         if (in == NULL)
             fprintf(stderr, "ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
@@ -157,6 +223,7 @@ int main(int argc, char** argv)
 
         parse_DIMACS(in, S);
         fclose(in);
+        int input_vars = S.nVars();   // Simplification may add variables (BVA); they are not in the model.
 		//MM: modifications to original minisat source code
         //FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
 		FILE* res = NULL;
@@ -167,7 +234,18 @@ int main(int argc, char** argv)
             fprintf(stderr, "|  Number of variables:  %12d                                         |\n", S.nVars());
             fprintf(stderr, "|  Number of clauses:    %12d                                         |\n", S.nClauses()); }
 
+        S.extractFeatures(features);
+        if (auto_preset){
+            const char* name = features.selectPreset();
+            config = SolverConfig();
+            config.applyPreset(name);
+            config.readCoreOptions().readSimpOptions();
+            S.setConfig(config);
+            if (S.verbosity > 0)
+                fprintf(stderr, "|  Preset:               %12s (selected)                              |\n", name); }
+
         double parsed_time = cpuTime();
+        stats.set("parse_time", parsed_time - initial_time);
         if (S.verbosity > 0)
             fprintf(stderr, "|  Parse time:           %12.2f s                                       |\n", parsed_time - initial_time);
 
@@ -180,6 +258,7 @@ int main(int argc, char** argv)
 
         S.eliminate(true);
         double simplified_time = cpuTime();
+        stats.set("simplify_time", simplified_time - parsed_time);
         if (S.verbosity > 0){
             fprintf(stderr, "|  Simplification time:  %12.2f s                                       |\n", simplified_time - parsed_time);
             fprintf(stderr, "|                                                                             |\n"); }
@@ -192,6 +271,9 @@ int main(int argc, char** argv)
                 printStats(S);
                 fprintf(stderr, "\n"); }
             fprintf(stderr, "UNSATISFIABLE\n");
+            closeProof(S);
+            if (proof_file != NULL) fclose(proof_file);
+            closeStats(stats, stats_file, 20);
             exit(20);
         }
 
@@ -201,6 +283,9 @@ int main(int argc, char** argv)
             S.toDimacs((const char*)dimacs);
             if (S.verbosity > 0)
                 printStats(S);
+            closeProof(S);
+            if (proof_file != NULL) fclose(proof_file);
+            closeStats(stats, stats_file, 0);
             exit(0);
         }
 
@@ -214,7 +299,7 @@ int main(int argc, char** argv)
         if (res != NULL){
             if (ret == l_True){
                 fprintf(res, "SAT\n");
-                for (int i = 0; i < S.nVars(); i++)
+                for (int i = 0; i < input_vars; i++)
                     if (S.model[i] != l_Undef)
                         fprintf(res, "%s%s%d", (i==0)?"":" ", (S.model[i]==l_True)?"":"-", i+1);
                 fprintf(res, " 0\n");
@@ -225,6 +310,11 @@ int main(int argc, char** argv)
             fclose(res);
         }
 
+        closeProof(S);
+        if (proof_file != NULL) fclose(proof_file);
+        stats.set("solve_time", cpuTime() - simplified_time);
+        closeStats(stats, stats_file, ret == l_True ? 10 : ret == l_False ? 20 : 0);
+
 #ifdef NDEBUG
         exit(ret == l_True ? 10 : ret == l_False ? 20 : 0);     // (faster than "return", which will invoke the destructor for 'Solver')
 #else
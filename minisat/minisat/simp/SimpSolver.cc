@@ -20,9 +20,15 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "minisat/mtl/Sort.h"
 #include "minisat/simp/SimpSolver.h"
+#include "minisat/core/DratWriter.h"
 #include "minisat/utils/System.h"
+#include "minisat/utils/Stats.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace Minisat;
 
@@ -31,37 +37,95 @@ using namespace Minisat;
 
 
 static const char* _cat = "SIMP";
-
-static BoolOption   opt_use_asymm        (_cat, "asymm",        "Shrink clauses by asymmetric branching.", false);
-static BoolOption   opt_use_rcheck       (_cat, "rcheck",       "Check if a clause is already implied. (costly)", false);
-static BoolOption   opt_use_elim         (_cat, "elim",         "Perform variable elimination.", true);
-static IntOption    opt_grow             (_cat, "grow",         "Allow a variable elimination step to grow by a number of clauses.", 0);
-static IntOption    opt_clause_lim       (_cat, "cl-lim",       "Variables are not eliminated if it produces a resolvent with a length above this limit. -1 means no limit", 20,   IntRange(-1, INT32_MAX));
-static IntOption    opt_subsumption_lim  (_cat, "sub-lim",      "Do not check if subsumption against a clause larger than this. -1 means no limit.", 1000, IntRange(-1, INT32_MAX));
-static DoubleOption opt_simp_garbage_frac(_cat, "simp-gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered during simplification.",  0.5, DoubleRange(0, false, HUGE_VAL, false));
+static const SolverConfig _def;     // The defaults.
+
+static BoolOption   opt_use_asymm        (_cat, "asymm",        "Shrink clauses by asymmetric branching.", _def.use_asymm);
+static BoolOption   opt_use_rcheck       (_cat, "rcheck",       "Check if a clause is already implied. (costly)", _def.use_rcheck);
+static BoolOption   opt_use_elim         (_cat, "elim",         "Perform variable elimination.", _def.use_elim);
+static BoolOption   opt_use_gates        (_cat, "gates",        "Only resolve gate against non-gate clauses when eliminating a variable defined by a gate.", _def.use_gates);
+static BoolOption   opt_use_bva          (_cat, "bva",          "Perform bounded variable addition before variable elimination.", _def.use_bva);
+static IntOption    opt_bva_lim          (_cat, "bva-lim",      "Bounded variable addition only adds a variable if it removes more than this many clauses.", _def.bva_lim, IntRange(0, INT32_MAX));
+static Int64Option  opt_bva_steps        (_cat, "bva-steps",    "Budget of bounded variable addition, in clause literals and matches visited.", _def.bva_steps, Int64Range(0, INT64_MAX));
+static BoolOption   opt_use_probe        (_cat, "probe",        "Probe the roots of the binary implication graph for failed literals and substitute equivalent literals.", _def.use_probe);
+static Int64Option  opt_probe_props      (_cat, "probe-props",  "Budget of probing, in propagated literals and visited clauses.", _def.probe_props, Int64Range(0, INT64_MAX));
+static DoubleOption opt_probe_effort     (_cat, "probe-effort", "Budget of probing at most, per literal of the clauses.", _def.probe_effort, DoubleRange(0, true, HUGE_VAL, false));
+static IntOption    opt_probe_threads    (_cat, "probe-threads","Threads probing the roots of the binary implication graph (1 = sequential).", _def.probe_threads, IntRange(1, 256));
+static IntOption    opt_elim_threads     (_cat, "elim-threads", "Threads computing the resolvents of variable elimination (1 = sequential).", _def.elim_threads, IntRange(1, 256));
+static IntOption    opt_grow             (_cat, "grow",         "Allow a variable elimination step to grow by a number of clauses.", _def.grow);
+static IntOption    opt_clause_lim       (_cat, "cl-lim",       "Variables are not eliminated if it produces a resolvent with a length above this limit. -1 means no limit", _def.clause_lim,   IntRange(-1, INT32_MAX));
+static IntOption    opt_subsumption_lim  (_cat, "sub-lim",      "Do not check if subsumption against a clause larger than this. -1 means no limit.", _def.subsumption_lim, IntRange(-1, INT32_MAX));
+static BoolOption   opt_fwd_sub          (_cat, "fwd-sub",      "Check new clauses for subsumption by the old ones (one-watch lists).", _def.use_fwd_sub);
+static DoubleOption opt_simp_garbage_frac(_cat, "simp-gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered during simplification.",  _def.simp_garbage_frac, DoubleRange(0, false, HUGE_VAL, false));
+
+
+SolverConfig& SolverConfig::readSimpOptions()
+{
+    readIfGiven(grow,              opt_grow);
+    readIfGiven(clause_lim,        opt_clause_lim);
+    readIfGiven(subsumption_lim,   opt_subsumption_lim);
+    readIfGiven(use_fwd_sub,       opt_fwd_sub);
+    readIfGiven(simp_garbage_frac, opt_simp_garbage_frac);
+    readIfGiven(use_asymm,         opt_use_asymm);
+    readIfGiven(use_rcheck,        opt_use_rcheck);
+    readIfGiven(use_elim,          opt_use_elim);
+    readIfGiven(use_gates,         opt_use_gates);
+    readIfGiven(use_probe,         opt_use_probe);
+    readIfGiven(probe_props,       opt_probe_props);
+    readIfGiven(probe_effort,      opt_probe_effort);
+    readIfGiven(probe_threads,     opt_probe_threads);
+    readIfGiven(use_bva,           opt_use_bva);
+    readIfGiven(bva_lim,           opt_bva_lim);
+    readIfGiven(bva_steps,         opt_bva_steps);
+    readIfGiven(elim_threads,      opt_elim_threads);
+    return *this;
+}
 
 
 //=================================================================================================
 // Constructor/Destructor:
 
 
-SimpSolver::SimpSolver() :
-    grow               (opt_grow)
-  , clause_lim         (opt_clause_lim)
-  , subsumption_lim    (opt_subsumption_lim)
-  , simp_garbage_frac  (opt_simp_garbage_frac)
-  , use_asymm          (opt_use_asymm)
-  , use_rcheck         (opt_use_rcheck)
-  , use_elim           (opt_use_elim)
+SimpSolver::SimpSolver() : SimpSolver(SolverConfig().readCoreOptions().readSimpOptions()) {}
+
+
+SimpSolver::SimpSolver(const SolverConfig& config) :
+    Solver             (config)
+  , grow               (config.grow)
+  , clause_lim         (config.clause_lim)
+  , subsumption_lim    (config.subsumption_lim)
+  , use_fwd_sub        (config.use_fwd_sub)
+  , simp_garbage_frac  (config.simp_garbage_frac)
+  , use_asymm          (config.use_asymm)
+  , use_rcheck         (config.use_rcheck)
+  , use_elim           (config.use_elim)
+  , use_gates          (config.use_gates)
+  , use_probe          (config.use_probe)
+  , probe_props        (config.probe_props)
+  , probe_effort       (config.probe_effort)
+  , probe_threads      (config.probe_threads)
+  , use_bva            (config.use_bva)
+  , bva_lim            (config.bva_lim)
+  , bva_steps          (config.bva_steps)
+  , elim_threads       (config.elim_threads)
   , merges             (0)
   , asymm_lits         (0)
   , eliminated_vars    (0)
+  , elim_rounds        (0)
+  , eliminated_gates   (0)
+  , subsumed_clauses   (0)
+  , strengthened_lits  (0)
+  , bva_vars           (0)
+  , bva_clauses        (0)
+  , failed_lits        (0)
+  , hbr_clauses        (0)
+  , substituted_vars   (0)
   , elimorder          (1)
   , use_simplification (true)
   , occurs             (ClauseDeleted(ca))
   , elim_heap          (ElimLt(n_occ))
   , bwdsub_assigns     (0)
   , n_touched          (0)
+  , sub_watches        (ClauseDeleted(ca))
 {
     vec<Lit> dummy(1,lit_Undef);
     ca.extra_clause_field = true; // NOTE: must happen before allocating the dummy clause below.
@@ -75,6 +139,29 @@ SimpSolver::~SimpSolver()
 }
 
 
+// Keeps 'use_fwd_sub': the one-watch lists of the clauses added so far exist only with it.
+void SimpSolver::setConfig(const SolverConfig& config)
+{
+    Solver::setConfig(config);
+    grow              = config.grow;
+    clause_lim        = config.clause_lim;
+    subsumption_lim   = config.subsumption_lim;
+    simp_garbage_frac = config.simp_garbage_frac;
+    use_asymm         = config.use_asymm;
+    use_rcheck        = config.use_rcheck;
+    use_elim          = config.use_elim;
+    use_gates         = config.use_gates;
+    use_probe         = config.use_probe;
+    probe_props       = config.probe_props;
+    probe_effort      = config.probe_effort;
+    probe_threads     = config.probe_threads;
+    use_bva           = config.use_bva;
+    bva_lim           = config.bva_lim;
+    bva_steps         = config.bva_steps;
+    elim_threads      = config.elim_threads;
+}
+
+
 Var SimpSolver::newVar(bool sign, bool dvar) {
     Var v = Solver::newVar(sign, dvar);
 
@@ -85,6 +172,10 @@ Var SimpSolver::newVar(bool sign, bool dvar) {
         n_occ     .push(0);
         n_occ     .push(0);
         occurs    .init(v);
+        sub_watches.init(mkLit(v, false));
+        sub_watches.init(mkLit(v, true));
+        sub_mark  .push(0);
+        sub_mark  .push(0);
         touched   .push(0);
         elim_heap .insert(v);
     }
@@ -138,6 +229,17 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
 
 
 bool SimpSolver::addClause_(vec<Lit>& ps)
+{
+    cancelUntil(0);
+    if (group_lits.size() > 0)
+        ps.push(~group_lits.last());
+    return addClauseNoGroup_(ps);
+}
+
+
+// Also used for the clauses derived by elimination and substitution: they contain the activation
+// literals of the clauses they were derived from already.
+bool SimpSolver::addClauseNoGroup_(vec<Lit>& ps)
 {
 #ifndef NDEBUG
     for (auto const& lit : ps) {
@@ -150,25 +252,33 @@ bool SimpSolver::addClause_(vec<Lit>& ps)
     if (use_rcheck && implied(ps))
         return true;
 
-    if (!Solver::addClause_(ps))
+    if (!Solver::addClauseNoGroup_(ps))
         return false;
 
     if (use_simplification && clauses.size() == nclauses + 1){
         CRef          cr = clauses.last();
         const Clause& c  = ca[cr];
 
-        // NOTE: the clause is added to the queue immediately and then
-        // again during 'gatherTouchedClauses()'. If nothing happens
-        // in between, it will only be checked once. Otherwise, it may
-        // be checked twice unnecessarily. This is an unfortunate
-        // consequence of how backward subsumption is used to mimic
-        // forward subsumption.
+        // NOTE: without 'use_fwd_sub', the clause is added to the queue
+        // immediately and then again during 'gatherTouchedClauses()'. If
+        // nothing happens in between, it will only be checked once.
+        // Otherwise, it may be checked twice unnecessarily. This is an
+        // unfortunate consequence of how backward subsumption is used to
+        // mimic forward subsumption. With 'use_fwd_sub', the queue checks
+        // the clause in both directions instead.
         subsumption_queue.insert(cr);
+        if (use_fwd_sub){
+            Lit w = c[0];
+            for (int i = 1; i < c.size(); i++)
+                if (n_occ[toInt(c[i])] < n_occ[toInt(w)])
+                    w = c[i];
+            sub_watches[w].push(cr); }
         for (int i = 0; i < c.size(); i++){
             occurs[var(c[i])].push(cr);
             n_occ[toInt(c[i])]++;
-            touched[var(c[i])] = 1;
-            n_touched++;
+            if (!use_fwd_sub){
+                touched[var(c[i])] = 1;
+                n_touched++; }
             if (elim_heap.inHeap(var(c[i])))
                 elim_heap.increase(var(c[i]));
         }
@@ -187,6 +297,7 @@ void SimpSolver::removeClause(CRef cr)
             n_occ[toInt(c[i])]--;
             updateElimHeap(var(c[i]));
             occurs.smudge(var(c[i]));
+            if (use_fwd_sub) sub_watches.smudge(c[i]);
         }
 
     Solver::removeClause(cr);
@@ -203,16 +314,23 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l)
     // if (!find(subsumption_queue, &c))
     subsumption_queue.insert(cr);
 
+    // The strengthened clause must be in the proof before the original is deleted:
+    if (proof) proof->addClause(c, l);
+
     if (c.size() == 2){
         removeClause(cr);
         c.strengthen(l);
     }else{
+        if (proof) proof->deleteClause(c);
         detachClause(cr, true);
         c.strengthen(l);
         attachClause(cr);
         remove(occurs[var(l)], cr);
         n_occ[toInt(l)]--;
         updateElimHeap(var(l));
+        if (use_fwd_sub && find(sub_watches[l], cr)){
+            remove(sub_watches[l], cr);
+            sub_watches[c[0]].push(cr); }
     }
 
     return c.size() == 1 ? enqueue(c[0]) && propagate() == CRef_Undef : true;
@@ -220,9 +338,8 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l)
 
 
 // Returns FALSE if clause is always satisfied ('out_clause' should not be used).
-bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause)
+static bool resolve(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause)
 {
-    merges++;
     out_clause.clear();
 
     bool  ps_smallest = _ps.size() < _qs.size();
@@ -252,10 +369,8 @@ bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& ou
 
 
 // Returns FALSE if clause is always satisfied.
-bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size)
+static bool resolventSize(const Clause& _ps, const Clause& _qs, Var v, int& size)
 {
-    merges++;
-
     bool  ps_smallest = _ps.size() < _qs.size();
     const Clause& ps  =  ps_smallest ? _qs : _ps;
     const Clause& qs  =  ps_smallest ? _ps : _qs;
@@ -282,6 +397,10 @@ bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size)
 }
 
 
+bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause) { merges++; return resolve(_ps, _qs, v, out_clause); }
+bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size)            { merges++; return resolventSize(_ps, _qs, v, size); }
+
+
 void SimpSolver::gatherTouchedClauses()
 {
     if (n_touched == 0) return;
@@ -291,8 +410,8 @@ void SimpSolver::gatherTouchedClauses()
         if (ca[subsumption_queue[i]].mark() == 0)
             ca[subsumption_queue[i]].mark(2);
 
-    for (auto& t : touched) {
-        if (t) {
+    for (i = 0; i < touched.size(); i++) {
+        if (touched[i]) {
             const vec<CRef>& cs = occurs.lookup(i);
             for (auto const& ref : cs) {
                 if (ca[ref].mark() == 0) {
@@ -300,7 +419,7 @@ void SimpSolver::gatherTouchedClauses()
                     ca[ref].mark(2);
                 }
             }
-            t = 0;
+            touched[i] = 0;
         }
     }
 
@@ -333,9 +452,92 @@ bool SimpSolver::implied(const vec<Lit>& c)
 }
 
 
+void SimpSolver::markLits(const Clause& c, char m)
+{
+    for (int i = 0; i < c.size(); i++)
+        sub_mark[toInt(c[i])] = m;
+}
+
+
+// As 'c.subsumes(d)', with the literals of 'c' marked (linear in the size of 'd').
+Lit SimpSolver::subsumesMarked(const Clause& c, const Clause& d) const
+{
+    if (d.size() < c.size() || (c.abstraction() & ~d.abstraction()) != 0)
+        return lit_Error;
+
+    Lit ret   = lit_Undef;
+    int found = 0;
+    for (int i = 0; i < d.size() && found + d.size() - i >= c.size(); i++)
+        if (sub_mark[toInt(d[i])])
+            found++;
+        else if (sub_mark[toInt(~d[i])]){
+            if (ret != lit_Undef) return lit_Error;
+            ret = ~d[i];
+            found++; }
+
+    return found == c.size() ? ret : lit_Error;
+}
+
+
+// As 'd.subsumes(c)', with the literals of 'c' marked, but the literal returned (if any) is the one
+// that can be deleted from 'c'.
+Lit SimpSolver::subsumedByMarked(const Clause& d) const
+{
+    Lit ret = lit_Undef;
+    for (int i = 0; i < d.size(); i++)
+        if (!sub_mark[toInt(d[i])]){
+            if (ret != lit_Undef || !sub_mark[toInt(~d[i])]) return lit_Error;
+            ret = ~d[i]; }
+
+    return ret;
+}
+
+
+// Forward subsumption + forward subsumption resolution: every clause that may subsume 'cr' (or
+// strengthen it) is in the one-watch list of a literal of 'cr' or of its negation. Sets 'changed'
+// if 'cr' was removed or strengthened (then it is back in the queue).
+bool SimpSolver::forwardSubsumptionCheck(CRef cr, bool& changed)
+{
+    const Clause& c    = ca[cr];
+    uint64_t      abst = c.abstraction();
+    changed = false;
+
+    if (subsumption_lim != -1 && c.size() >= subsumption_lim)
+        return true;
+
+    markLits(c, 1);
+    for (int i = 0; i < c.size(); i++)
+        for (int k = 0; k < 2; k++){
+            const vec<CRef>& ws = sub_watches[k == 0 ? c[i] : ~c[i]];   // Deleted clauses are skipped (not cleaned).
+            for (int j = 0; j < ws.size(); j++){
+                const Clause& d = ca[ws[j]];
+                if (ws[j] == cr || d.mark() || d.size() > c.size() || (d.abstraction() & ~abst) != 0)
+                    continue;
+
+                Lit l = subsumedByMarked(d);
+                if (l == lit_Error)
+                    continue;
+
+                markLits(c, 0);
+                changed = true;
+                if (l == lit_Undef){
+                    ++subsumed_clauses, removeClause(cr);
+                    return true; }
+                ++strengthened_lits;
+                return strengthenClause(cr, l);
+            }
+        }
+    markLits(c, 0);
+
+    return true;
+}
+
+
 // Backward subsumption + backward subsumption resolution
 bool SimpSolver::backwardSubsumptionCheck(bool verbose)
 {
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_Subsume);
+
     int cnt = 0;
     int subsumed = 0;
     int deleted_literals = 0;
@@ -366,34 +568,76 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose)
 
         assert(c.size() > 1 || value(c[0]) == l_True);    // Unit-clauses should have been propagated before this point.
 
+        if (use_fwd_sub && cr != bwdsub_tmpunit){
+            bool changed;
+            if (!forwardSubsumptionCheck(cr, changed))
+                return false;
+            if (changed)
+                continue;
+        }
+
         // Find best variable to scan:
         Var best = var(c[0]);
         for (int i = 1; i < c.size(); i++)
             if (occurs[var(c[i])].size() < occurs[best].size())
                 best = var(c[i]);
 
-        // Search all candidates:
-        vec<CRef>& cs = occurs.lookup(best);
+        // Search the clauses of 'best', or, when comparing with these would read many more literals than
+        // there are occurrences of all variables of 'c' (to sort), only the clauses that contain them all:
+        vec<CRef>& cs      = occurs.lookup(best);
+        bool       counted = false;
+        if (cs.size() >= 16){
+            uint64_t scan  = 0;
+            uint64_t total = 0;
+            for (int j = 0; j < cs.size(); j++){
+                const Clause& d = ca[cs[j]];
+                if (d.size() >= c.size() && (subsumption_lim == -1 || d.size() < subsumption_lim) && (c.abstraction() & ~d.abstraction()) == 0)
+                    scan += d.size(); }
+            for (int i = 0; i < c.size(); i++)
+                total += occurs[var(c[i])].size();
+
+            if (scan > 16 * total){
+                bwdsub_cands.clear();
+                for (int i = 0; i < c.size(); i++){
+                    const vec<CRef>& os = occurs.lookup(var(c[i]));
+                    for (int j = 0; j < os.size(); j++)
+                        bwdsub_cands.push(os[j]); }
+                sort(bwdsub_cands);
+                int i, j, k;
+                for (i = j = 0; i < bwdsub_cands.size(); i = k){
+                    for (k = i + 1; k < bwdsub_cands.size() && bwdsub_cands[k] == bwdsub_cands[i]; k++);
+                    if (k - i == c.size())
+                        bwdsub_cands[j++] = bwdsub_cands[i]; }
+                bwdsub_cands.shrink(i - j);
+                counted = true;
+            }
+        }
+        vec<CRef>& cands = counted ? bwdsub_cands : cs;
 
-        for (int j = 0; j < cs.size(); j++) {
+        // Search all candidates (short clauses are faster to compare directly, without marks):
+        bool marked = c.size() > 8;
+        if (marked) markLits(c, 1);
+        for (int j = 0; j < cands.size(); j++) {
             if (c.mark()) {
                 break;
-            } else if (!ca[cs[j]].mark() && cs[j] != cr && (subsumption_lim == -1 || ca[cs[j]].size() < subsumption_lim)) {
-                Lit l = c.subsumes(ca[cs[j]]);
+            } else if (!ca[cands[j]].mark() && cands[j] != cr && (subsumption_lim == -1 || ca[cands[j]].size() < subsumption_lim)) {
+                Lit l = marked ? subsumesMarked(c, ca[cands[j]]) : c.subsumes(ca[cands[j]]);
                 if (l == lit_Undef) {
-                    ++subsumed, removeClause(cs[j]);
+                    ++subsumed, ++subsumed_clauses, removeClause(cands[j]);
                 } else if (l != lit_Error) {
-                    ++deleted_literals;
-                    if (!strengthenClause(cs[j], ~l)) {
+                    ++deleted_literals, ++strengthened_lits;
+                    if (!strengthenClause(cands[j], ~l)) {
+                        if (marked) markLits(c, 0);
                         return false;
                     }
                     // Did current candidate get deleted from cs? Then check candidate at index j again:
-                    if (var(l) == best) {
+                    if (!counted && var(l) == best) {
                         --j;
                     }
                 }
             }
         }
+        if (marked) markLits(c, 0);
     }
 
     return true;
@@ -453,6 +697,15 @@ static void mkElimClause(vec<uint32_t>& elimclauses, Lit x)
 }
 
 
+// The binary clause '(x | y)', satisfied by 'x' when extending the model:
+static void mkElimClause(vec<uint32_t>& elimclauses, Lit x, Lit y)
+{
+    elimclauses.push(toInt(x));
+    elimclauses.push(toInt(y));
+    elimclauses.push(2);
+}
+
+
 static void mkElimClause(vec<uint32_t>& elimclauses, Var v, Clause& c)
 {
     int first = elimclauses.size();
@@ -477,6 +730,105 @@ static void mkElimClause(vec<uint32_t>& elimclauses, Var v, Clause& c)
 
 
 
+// The index in 'cs' of the ternary clause (a | b | c), or -1:
+static int findTernary(const ClauseAllocator& ca, const vec<CRef>& cs, Lit a, Lit b, Lit c)
+{
+    for (int i = 0; i < cs.size(); i++){
+        const Clause& cl = ca[cs[i]];
+        if (cl.size() == 3 && find(cl, a) && find(cl, b) && find(cl, c))
+            return i; }
+    return -1;
+}
+
+
+// Looks for a gate defining 'v': 'x = AND(a_1, .., a_k)' for 'x' = 'v' or '~v' (which includes
+// equivalences and OR gates), or 'v = ITE(c, t, e)' (which includes XORs, with 'e' = '~t'). If one is
+// found, its clauses are moved to the front of 'pos' and 'neg', and 'gpos' and 'gneg' are set to their
+// numbers. Resolvents of two gate clauses are tautologies and those of two other clauses are implied
+// by the remaining ones, so only gate against non-gate clauses need to be resolved. The gate
+// fixes 'v' for every assignment of its inputs, so 'extendModel()' still finds its value from the
+// clauses of one side. 'tmp' is scratch space.
+bool SimpSolver::findGate(Var v, vec<CRef>& pos, vec<CRef>& neg, vec<Lit>& tmp, int& gpos, int& gneg) const
+{
+    gpos = gneg = 0;
+
+    // AND gates, 'x = AND(a_1, .., a_k)': the binary clauses (~x | a_i) and (x | ~a_1 | .. | ~a_k):
+    for (int sgn = 0; sgn < 2; sgn++){
+        Lit        x  = mkLit(v, sgn);
+        vec<CRef>& xs = sgn ? neg : pos;
+        vec<CRef>& ns = sgn ? pos : neg;
+
+        tmp.clear();
+        for (int i = 0; i < ns.size(); i++){
+            const Clause& c = ca[ns[i]];
+            if (c.size() == 2)
+                tmp.push(c[0] == ~x ? c[1] : c[0]); }
+        if (tmp.size() == 0) continue;
+        sort(tmp);
+
+        for (int i = 0; i < xs.size(); i++){
+            const Clause& c = ca[xs[i]];
+            if (c.size() - 1 > tmp.size()) continue;
+
+            int k = 0;
+            while (k < c.size() && (c[k] == x || std::binary_search(tmp.begin(), tmp.end(), ~c[k])))
+                k++;
+            if (k < c.size()) continue;
+
+            // Found: move the gate clauses to the front:
+            int& gx = sgn ? gneg : gpos;
+            int& gn = sgn ? gpos : gneg;
+            std::swap(xs[0], xs[i]);
+            gx = 1;
+            for (k = 0; k < c.size(); k++)
+                if (c[k] != x)
+                    for (int j = gn; j < ns.size(); j++){
+                        const Clause& b = ca[ns[j]];
+                        if (b.size() == 2 && (b[0] == ~c[k] || b[1] == ~c[k])){
+                            std::swap(ns[gn++], ns[j]);
+                            break; } }
+            return true;
+        }
+    }
+
+    // ITE gates, 'x = ITE(c, t, e)': (~x | ~c | t), (x | ~c | ~t), (~x | c | e) and (x | c | ~e). With
+    // 's' = '~c', 'a' is the first of these and 'b' the third:
+    Lit x = mkLit(v);
+    for (int i = 0; i < neg.size(); i++){
+        const Clause& a = ca[neg[i]];
+        if (a.size() != 3) continue;
+
+        for (int k = 0; k < 3; k++){
+            if (a[k] == ~x) continue;
+            Lit s = a[k];
+            Lit t = a[0] != ~x && a[0] != s ? a[0] : a[1] != ~x && a[1] != s ? a[1] : a[2];
+
+            int p1 = findTernary(ca, pos, x, s, ~t);
+            if (p1 < 0) continue;
+
+            for (int j = 0; j < neg.size(); j++){
+                const Clause& b = ca[neg[j]];
+                if (b.size() != 3 || !find(b, ~s)) continue;
+                Lit e = b[0] != ~x && b[0] != ~s ? b[0] : b[1] != ~x && b[1] != ~s ? b[1] : b[2];
+
+                int p2 = findTernary(ca, pos, x, ~s, ~e);
+                if (p2 < 0) continue;
+
+                // Found: move the gate clauses to the front:
+                std::swap(neg[0], neg[i]);
+                std::swap(neg[1], neg[j == 0 ? i : j]);
+                std::swap(pos[0], pos[p1]);
+                std::swap(pos[1], pos[p2 == 0 ? p1 : p2]);
+                gpos = gneg = 2;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
 bool SimpSolver::eliminateVar(Var v)
 {
     assert(!frozen[v]);
@@ -490,15 +842,24 @@ bool SimpSolver::eliminateVar(Var v)
     for (int i = 0; i < cls.size(); i++)
         (find(ca[cls[i]], mkLit(v)) ? pos : neg).push(cls[i]);
 
+    // If 'v' is defined by a gate, only the gate clauses (the first 'gpos' and 'gneg') are resolved
+    // against the others:
+    //
+    vec<Lit>& resolvent = add_tmp;
+    int       gpos      = 0;
+    int       gneg      = 0;
+    bool      gate      = use_gates && findGate(v, pos, neg, resolvent, gpos, gneg);
+
     // Check wether the increase in number of clauses stays within the allowed ('grow'). Moreover, no
     // clause must exceed the limit on the maximal clause size (if it is set):
     //
     int cnt         = 0;
     int clause_size = 0;
 
-    for (const auto& p : pos) {
-        for (const auto& n : neg) {
-            if (merge(ca[p], ca[n], v, clause_size) &&
+    for (int i = 0; i < pos.size(); i++) {
+        for (int j = 0; j < neg.size(); j++) {
+            if (gate && (i < gpos) == (j < gneg)) continue;
+            if (merge(ca[pos[i]], ca[neg[j]], v, clause_size) &&
                 (++cnt > cls.size() + grow || (clause_lim != -1 && clause_size > clause_lim))) {
                 return true;
             }
@@ -506,6 +867,44 @@ bool SimpSolver::eliminateVar(Var v)
     }
 
     // Delete and store old clauses:
+    storeElimClauses(v, pos, neg);
+    if (gate) eliminated_gates++;
+
+    // The resolvents must be in the proof before their antecedents are deleted:
+    if (proof)
+        for (int i = 0; i < pos.size(); i++)
+            for (int j = 0; j < neg.size(); j++)
+                if ((!gate || (i < gpos) != (j < gneg)) && merge(ca[pos[i]], ca[neg[j]], v, resolvent))
+                    proof->addClause(resolvent);
+
+    for (auto const& cl : cls) {
+        removeClause(cl);
+    }
+
+    // Produce clauses in cross product:
+    for (int i = 0; i < pos.size(); i++) {
+        for (int j = 0; j < neg.size(); j++) {
+            if (gate && (i < gpos) == (j < gneg)) continue;
+            if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addClauseNoGroup_(resolvent)) {
+                return false;
+            }
+        }
+    }
+
+    // Free occurs list for this variable:
+    occurs[v].clear(true);
+
+    // Free watchers lists for this variable, if possible:
+    if (watches[ mkLit(v)].size() == 0) watches[ mkLit(v)].clear(true);
+    if (watches[~mkLit(v)].size() == 0) watches[~mkLit(v)].clear(true);
+
+    return backwardSubsumptionCheck();
+}
+
+
+// Marks 'v' eliminated and stores the clauses of the smaller side for 'extendModel()':
+void SimpSolver::storeElimClauses(Var v, const vec<CRef>& pos, const vec<CRef>& neg)
+{
     eliminated[v] = true;
     setDecisionVar(v, false);
     eliminated_vars++;
@@ -521,20 +920,97 @@ bool SimpSolver::eliminateVar(Var v)
         }
         mkElimClause(elimclauses, ~mkLit(v));
     }
+}
 
-    for (auto const& cl : cls) {
-        removeClause(cl);
+
+// The part of 'eliminateVar()' that only reads the clauses, run by the threads of
+// 'eliminateRound()' (the resolvents go to 'out'; 'pos', 'neg', 'out' and 'tmp' belong to the thread):
+void SimpSolver::elimResolvents(ElimTask& t, vec<CRef>& pos, vec<CRef>& neg, vec<Lit>& out, vec<Lit>& tmp) const
+{
+    const vec<CRef>& cls = occurs[t.v];
+    t.elim      = false;
+    t.gate      = false;
+    t.merges    = 0;
+    t.res_start = t.res_end = out.size();
+    pos.clear();
+    neg.clear();
+    for (int i = 0; i < cls.size(); i++)
+        (find(ca[cls[i]], mkLit(t.v)) ? pos : neg).push(cls[i]);
+
+    int gpos = 0;
+    int gneg = 0;
+    if (use_gates) t.gate = findGate(t.v, pos, neg, tmp, gpos, gneg);
+
+    int cnt         = 0;
+    int clause_size = 0;
+
+    for (int i = 0; i < pos.size(); i++) {
+        for (int j = 0; j < neg.size(); j++) {
+            if (t.gate && (i < gpos) == (j < gneg)) continue;
+            t.merges++;
+            if (resolventSize(ca[pos[i]], ca[neg[j]], t.v, clause_size) &&
+                (++cnt > cls.size() + grow || (clause_lim != -1 && clause_size > clause_lim))) {
+                return;
+            }
+        }
     }
 
-    // Produce clauses in cross product:
-    vec<Lit>& resolvent = add_tmp;
-    for (const auto& p : pos) {
-        for (const auto& n : neg) {
-            if (merge(ca[p], ca[n], v, resolvent) && !addClause_(resolvent)) {
-                return false;
+    for (int i = 0; i < pos.size(); i++) {
+        for (int j = 0; j < neg.size(); j++) {
+            if (t.gate && (i < gpos) == (j < gneg)) continue;
+            t.merges++;
+            if (resolve(ca[pos[i]], ca[neg[j]], t.v, tmp)) {
+                for (int i = 0; i < tmp.size(); i++)
+                    out.push(tmp[i]);
+                out.push(lit_Undef);
             }
         }
     }
+    t.res_end = out.size();
+    t.elim    = true;
+}
+
+
+// The part of 'eliminateVar()' that changes the clauses, except for the subsumption check. Skips
+// the variable if it was assigned by a unit resolvent of an earlier variable of the round. The
+// clauses of 'v' are the ones the thread saw, since no earlier variable of the round shares one.
+bool SimpSolver::commitElim(const ElimTask& t, const vec<Lit>& resolvents)
+{
+    Var v = t.v;
+    merges += t.merges;
+    if (!t.elim || value(v) != l_Undef)
+        return true;
+
+    vec<CRef> pos, neg;
+    const vec<CRef>& cls = occurs.lookup(v);
+    for (int i = 0; i < cls.size(); i++)
+        (find(ca[cls[i]], mkLit(v)) ? pos : neg).push(cls[i]);
+
+    storeElimClauses(v, pos, neg);
+    if (t.gate) eliminated_gates++;
+
+    // The resolvents must be in the proof before their antecedents are deleted:
+    vec<Lit>& resolvent = add_tmp;
+    resolvent.clear();
+    if (proof){
+        for (int i = t.res_start; i < t.res_end; i++)
+            if (resolvents[i] != lit_Undef)
+                resolvent.push(resolvents[i]);
+            else{
+                proof->addClause(resolvent);
+                resolvent.clear(); }
+    }
+
+    for (const auto& p : pos) removeClause(p);
+    for (const auto& n : neg) removeClause(n);
+
+    for (int i = t.res_start; i < t.res_end; i++)
+        if (resolvents[i] != lit_Undef)
+            resolvent.push(resolvents[i]);
+        else{
+            if (!addClauseNoGroup_(resolvent))
+                return false;
+            resolvent.clear(); }
 
     // Free occurs list for this variable:
     occurs[v].clear(true);
@@ -543,12 +1019,91 @@ bool SimpSolver::eliminateVar(Var v)
     if (watches[ mkLit(v)].size() == 0) watches[ mkLit(v)].clear(true);
     if (watches[~mkLit(v)].size() == 0) watches[~mkLit(v)].clear(true);
 
-    return backwardSubsumptionCheck();
+    return true;
+}
+
+
+// One round of parallel variable elimination: takes variables from 'elim_heap' (cheapest first)
+// such that no two of them occur in a common clause, computes their resolvents on 'elim_threads'
+// threads and eliminates them in the order they were taken. Eliminating a variable of the round
+// then neither changes the clauses of another one nor adds clauses with it, so what the threads
+// computed stays valid and the result does not depend on their timing. Variables skipped for
+// sharing a clause go back to the heap for the next round; backward subsumption of the resolvents
+// (on the subsumption queue) is left to the caller.
+bool SimpSolver::eliminateRound()
+{
+    const int max_round = 256;    // Variables taken, and skipped, at most in a round (small rounds keep their clauses in the cache).
+
+    elim_mark.growTo(nVars(), 0);
+    vec<Var> marked, deferred;
+    int      n = 0;
+    while (!elim_heap.empty() && n < max_round && deferred.size() < max_round){
+        Var v = elim_heap.removeMin();
+        if (isEliminated(v) || value(v) != l_Undef || frozen[v]) continue;
+        if (elim_mark[v]){ deferred.push(v); continue; }
+
+        const vec<CRef>& cls = occurs.lookup(v);
+        for (int i = 0; i < cls.size(); i++){
+            const Clause& c = ca[cls[i]];
+            for (int j = 0; j < c.size(); j++)
+                if (!elim_mark[var(c[j])]){
+                    elim_mark[var(c[j])] = 1;
+                    marked.push(var(c[j])); }
+        }
+        if (n == elim_tasks.size()) elim_tasks.push();
+        elim_tasks[n++].v = v;
+    }
+    elim_rounds++;
+
+    if (verbosity >= 2)
+        fprintf(stderr, "elimination left: %10d (round of %d)\r", elim_heap.size(), n);
+
+    // Compute the resolvents (small rounds are not worth starting threads for):
+    // Each thread appends its resolvents to those of the round when it is done:
+    int nthreads = n < 64 ? 1 : elim_threads;
+    vec<Lit>         resolvents;
+    std::mutex       mtx;
+    std::atomic<int> next(0);
+    auto work = [this, n, &next, &resolvents, &mtx](){
+        vec<CRef> pos, neg;
+        vec<Lit>  out, tmp;
+        vec<int>  done;
+        for (int i; (i = next++) < n;){
+            elimResolvents(elim_tasks[i], pos, neg, out, tmp);
+            done.push(i); }
+
+        std::lock_guard<std::mutex> lock(mtx);
+        int base = resolvents.size();
+        for (int i = 0; i < out.size(); i++)
+            resolvents.push(out[i]);
+        for (int i = 0; i < done.size(); i++){
+            elim_tasks[done[i]].res_start += base;
+            elim_tasks[done[i]].res_end   += base; } };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < nthreads; i++)
+        threads.emplace_back(work);
+    work();
+    for (auto& t : threads)
+        t.join();
+
+    bool result = true;
+    for (int i = 0; i < n && result; i++)
+        result = commitElim(elim_tasks[i], resolvents);
+
+    for (int i = 0; i < marked.size(); i++)
+        elim_mark[marked[i]] = 0;
+    for (int i = 0; i < deferred.size(); i++)
+        if (!elim_heap.inHeap(deferred[i]))
+            elim_heap.insert(deferred[i]);
+
+    checkGarbage(simp_garbage_frac);
+    return result;
 }
 
 
 bool SimpSolver::substitute(Var v, Lit x)
 {
+    cancelUntil(0);
     assert(!frozen[v]);
     assert(!isEliminated(v));
     assert(value(v) == l_Undef);
@@ -557,23 +1112,41 @@ bool SimpSolver::substitute(Var v, Lit x)
 
     eliminated[v] = true;
     setDecisionVar(v, false);
-    const vec<CRef>& cls = occurs.lookup(v);
+    substituted_vars++;
+
+    // 'v' takes the value of 'x' in the model:
+    mkElimClause(elimclauses, mkLit(v), ~x);
+    mkElimClause(elimclauses, ~mkLit(v), x);
 
+    vec<CRef> cls;
+    occurs.lookup(v).copyTo(cls);
+
+    // The equivalence may only be implied through clauses of 'v', so every substituted clause goes
+    // to the proof before any of them is deleted:
     vec<Lit>& subst_clause = add_tmp;
-    for (int i = 0; i < cls.size(); i++){
-        Clause& c = ca[cls[i]];
+    for (int k = proof ? 0 : 1; k < 2; k++)
+        for (int i = 0; i < cls.size(); i++){
+            const Clause& c = ca[cls[i]];
+
+            // Only the substituted literal and a literal of 'var(x)' can clash:
+            Lit sub = lit_Undef, other = lit_Undef;
+            subst_clause.clear();
+            for (int j = 0; j < c.size(); j++){
+                Lit p = var(c[j]) == v ? (sub = x ^ sign(c[j])) : c[j];
+                if (var(c[j]) == var(x)) other = c[j];
+                subst_clause.push(p);
+            }
+            bool taut = sub != lit_Undef && sub == ~other;
 
-        subst_clause.clear();
-        for (int j = 0; j < c.size(); j++){
-            Lit p = c[j];
-            subst_clause.push(var(p) == v ? x ^ sign(p) : p);
-        }
+            if (k == 0){
+                if (!taut) proof->addClause(subst_clause);
+                continue; }
 
-        removeClause(cls[i]);
+            removeClause(cls[i]);
 
-        if (!addClause_(subst_clause))
-            return ok = false;
-    }
+            if (!taut && !addClauseNoGroup_(subst_clause))
+                return ok = false;
+        }
 
     return true;
 }
@@ -596,13 +1169,587 @@ void SimpSolver::extendModel()
 }
 
 
+// Bounded variable addition (Manthey, Heule and Biere, 2012): if the clauses '(l_i | C_j)' are
+// present for every literal 'l_i' of a set 'L' and every clause 'C_j' of a set 'M', they are
+// replaced by the clauses '(l_i | x)' and '(~x | C_j)' with a new variable 'x'. This removes
+// '|L| * |M| - |L| - |M|' clauses; repeated, it takes the pairwise encoding of an at-most-one
+// constraint from a quadratic to a linear number of clauses. The replaced clauses are
+// the resolvents on 'x', so a model of the result is a model of the original clauses, and the new
+// clauses are RAT on 'x' in the proof. 'L' is grown greedily from the literal with the most
+// occurrences, taking each time the literal that keeps most of 'M', as long as the reduction grows.
+bool SimpSolver::boundedVariableAddition()
+{
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_Bva);
+    assert(decisionLevel() == 0);
+
+    // Occurrence lists of the literals, without the clauses that contain an assigned literal:
+    ClauseDeleted                           deleted(ca);
+    OccLists<Lit, vec<CRef>, ClauseDeleted> occs(deleted);
+    for (Var v = 0; v < nVars(); v++){
+        occs.init(mkLit(v, false));
+        occs.init(mkLit(v, true)); }
+    for (int i = 0; i < clauses.size(); i++){
+        const Clause& c = ca[clauses[i]];
+        int k = 0;
+        while (k < c.size() && value(c[k]) == l_Undef)
+            k++;
+        if (c.mark() == 0 && k == c.size())
+            for (k = 0; k < c.size(); k++)
+                occs[c[k]].push(clauses[i]);
+    }
+
+    Heap<BvaLt> queue((BvaLt(n_occ)));
+    for (int i = 0; i < 2*nVars(); i++)
+        if (n_occ[i] >= 3 && occs[toLit(i)].size() > 0)
+            queue.insert(i);
+
+    vec<char> seen(2*nVars(), 0);     // The literals of the clause being matched.
+    vec<int>  count(2*nVars(), 0);    // Clauses of 'M' each literal was matched with.
+    vec<int>  stamp(2*nVars(), -1);   // The last clause each literal was matched with.
+    vec<Lit>  lits;                   // 'L'.
+    vec<CRef> cls;                    // The clauses with 'l' ('M' is the part marked in 'keep').
+    vec<Lit>  match_lits;             // The literals matched with the clauses with 'l',
+    vec<int>  match_idx;              // the indices of these clauses in 'cls'
+    vec<CRef> match_cls;              // and the clauses matching them.
+    vec<char> keep;                   // Indexed as 'cls': the clause is still in 'M'.
+    vec<CRef> rm_cls;                 // The clauses matching 'M' with the literals of 'L',
+    vec<int>  rm_idx;                 // and the indices in 'cls' of the clauses they match.
+    int64_t   steps = 0;
+
+    while (!queue.empty() && steps < bva_steps && !asynch_interrupt){
+        Lit l = toLit(queue.removeMin());
+        if (n_occ[toInt(l)] < 3) break;
+
+        // Match each clause 'C' with 'l' with the literals 'p' such that '(C \ {l}) | p' is present.
+        // This is done once: the matches of a clause do not depend on 'L', and 'M' only shrinks:
+        occs.lookup(l).copyTo(cls);
+        match_lits.clear();
+        match_idx.clear();
+        match_cls.clear();
+        for (int i = 0; i < cls.size(); i++){
+            const Clause& c = ca[cls[i]];
+            Lit lmin = lit_Undef;
+            for (int k = 0; k < c.size(); k++){
+                seen[toInt(c[k])] = 1;
+                if (c[k] != l && (lmin == lit_Undef || occs[c[k]].size() < occs[lmin].size()))
+                    lmin = c[k]; }
+
+            const vec<CRef>& ds = occs.lookup(lmin);
+            for (int j = 0; j < ds.size(); j++){
+                const Clause& d = ca[ds[j]];
+                if (d.size() != c.size() || ds[j] == cls[i]) continue;
+                steps += d.size();
+
+                Lit p = lit_Undef;
+                int k = 0;
+                for (; k < d.size(); k++)
+                    if (!seen[toInt(d[k])] || d[k] == l){
+                        if (p != lit_Undef) break;
+                        p = d[k]; }
+                if (k < d.size() || p == lit_Undef || p == l || stamp[toInt(p)] == i) continue;
+
+                stamp[toInt(p)] = i;
+                match_lits.push(p);
+                match_idx.push(i);
+                match_cls.push(ds[j]);
+            }
+
+            for (int k = 0; k < c.size(); k++)
+                seen[toInt(c[k])] = 0;
+        }
+        for (int i = 0; i < match_lits.size(); i++)
+            stamp[toInt(match_lits[i])] = -1;
+
+        // Grow 'L' by the literal matched with most clauses of 'M' (the first one on ties), as long as
+        // the reduction grows. The matches of the literals of 'L' move to 'rm_cls' and 'rm_idx':
+        lits.clear();
+        lits.push(l);
+        keep.clear();
+        keep.growTo(cls.size(), 1);
+        rm_cls.clear();
+        rm_idx.clear();
+        int size = cls.size();
+        for (;;){
+            steps += match_lits.size();
+            Lit best = lit_Undef;
+            for (int i = 0; i < match_lits.size(); i++){
+                Lit p = match_lits[i];
+                if (++count[toInt(p)] > (best == lit_Undef ? 0 : count[toInt(best)]))
+                    best = p; }
+            int n = best == lit_Undef ? 0 : count[toInt(best)];
+            for (int i = 0; i < match_lits.size(); i++)
+                count[toInt(match_lits[i])] = 0;
+
+            int m = lits.size();
+            if (n == 0 || (m + 1) * n - (m + 1) - n <= m * size - m - size)
+                break;
+
+            lits.push(best);
+            size = n;
+            for (int i = 0; i < match_lits.size(); i++)
+                if (match_lits[i] == best){
+                    keep[match_idx[i]] = 2;
+                    rm_cls.push(match_cls[i]);
+                    rm_idx.push(match_idx[i]); }
+            for (int i = 0; i < keep.size(); i++)
+                keep[i] = keep[i] == 2;
+
+            int j = 0;
+            for (int i = 0; i < match_lits.size(); i++)
+                if (keep[match_idx[i]] && match_lits[i] != best){
+                    match_lits[j] = match_lits[i];
+                    match_idx [j] = match_idx [i];
+                    match_cls [j] = match_cls [i];
+                    j++; }
+            match_lits.shrink(match_lits.size() - j);
+            match_idx .shrink(match_idx .size() - j);
+            match_cls .shrink(match_cls .size() - j);
+        }
+
+        if (lits.size() < 2 || lits.size() * size - lits.size() - size <= bva_lim)
+            continue;
+
+        // Add the new clauses (each with the pivot first, for the proof):
+        Var x = newVar();
+        occs.init(mkLit(x, false));
+        occs.init(mkLit(x, true));
+        seen  .growTo(2*nVars(), 0);
+        count .growTo(2*nVars(), 0);
+        stamp .growTo(2*nVars(), -1);
+
+        auto add = [&](vec<Lit>& ps) {
+            if (proof) proof->addClause(ps);
+            int ncls = clauses.size();
+            if (!addClauseNoGroup_(ps))
+                return false;
+            if (clauses.size() == ncls + 1){
+                const Clause& c = ca[clauses.last()];
+                for (int k = 0; k < c.size(); k++)
+                    occs[c[k]].push(clauses.last()); }
+            return true;
+        };
+
+        vec<Lit>& ps = add_tmp;
+        for (int i = 0; i < lits.size(); i++){
+            ps.clear();
+            ps.push(mkLit(x));
+            ps.push(lits[i]);
+            if (!add(ps)) return false; }
+        for (int i = 0; i < cls.size(); i++){
+            if (!keep[i]) continue;
+            const Clause& c = ca[cls[i]];
+            ps.clear();
+            ps.push(~mkLit(x));
+            for (int k = 0; k < c.size(); k++)
+                if (c[k] != l)
+                    ps.push(c[k]);
+            if (!add(ps)) return false; }
+
+        // Remove the replaced clauses: 'M' and the clauses matching it with the literals of 'L' (a
+        // match is shared by the duplicates in 'M'):
+        auto remove = [&](CRef cr) {
+            const Clause& c = ca[cr];
+            for (int k = 0; k < c.size(); k++)
+                occs.smudge(c[k]);
+            removeClause(cr);
+            bva_clauses++;
+        };
+
+        for (int i = 0; i < cls.size(); i++)
+            if (keep[i])
+                remove(cls[i]);
+        for (int i = 0; i < rm_cls.size(); i++)
+            if (keep[rm_idx[i]] && ca[rm_cls[i]].mark() == 0)
+                remove(rm_cls[i]);
+
+        bva_vars++;
+        bva_clauses -= lits.size() + size;
+
+        // The literals of 'M' lost occurrences:
+        const vec<CRef>& xs = occs[~mkLit(x)];
+        for (int i = 0; i < xs.size(); i++){
+            const Clause& c = ca[xs[i]];
+            for (int k = 0; k < c.size(); k++)
+                if (queue.inHeap(toInt(c[k])))
+                    queue.update(toInt(c[k])); }
+        for (int i = 0; i < lits.size(); i++)
+            queue.update(toInt(lits[i]));
+        queue.update(toInt(mkLit(x)));
+        queue.update(toInt(~mkLit(x)));
+    }
+
+    if (verbosity >= 1 && bva_vars > 0)
+        fprintf(stderr, "|  BVA:                  %12d vars, %12d clauses removed      |\n", bva_vars, bva_clauses);
+
+    return true;
+}
+
+
+// The binary implication graph of the clauses without assigned literals ('(p | q)' gives the
+// edges '~p -> q' and '~q -> p'), and with 'with_long' the longer unsatisfied clauses by literal.
+// Both are copies, so they stay valid while clauses are added and removed.
+void SimpSolver::buildProbeGraph(ProbeGraph& g, bool with_long) const
+{
+    int n = 2*nVars();
+    g.bin_start.clear(); g.bin_start.growTo(n+1, 0);
+    g.occ_start.clear(); g.occ_start.growTo(n+1, 0);
+
+    // Count, then fill from the back of each range:
+    for (int k = 0; k < 2; k++){
+        for (int i = 0; i < clauses.size(); i++){
+            const Clause& c = ca[clauses[i]];
+            if (c.mark()) continue;
+
+            bool sat = false, assigned = false;
+            for (int j = 0; j < c.size() && !sat; j++){
+                sat      |= value(c[j]) == l_True;
+                assigned |= value(c[j]) != l_Undef; }
+            if (sat || (assigned && c.size() == 2)) continue;
+
+            if (c.size() == 2){
+                if (k == 0){
+                    g.bin_start[toInt(~c[0])]++;
+                    g.bin_start[toInt(~c[1])]++;
+                }else{
+                    g.bin[--g.bin_start[toInt(~c[0])]] = c[1];
+                    g.bin[--g.bin_start[toInt(~c[1])]] = c[0]; }
+            }else if (with_long)
+                for (int j = 0; j < c.size(); j++)
+                    if (value(c[j]) == l_Undef){
+                        if (k == 0) g.occ_start[toInt(c[j])]++;
+                        else        g.occ[--g.occ_start[toInt(c[j])]] = clauses[i]; }
+        }
+
+        if (k == 0){
+            for (int i = 0; i < n; i++){
+                g.bin_start[i+1] += g.bin_start[i];
+                g.occ_start[i+1] += g.occ_start[i]; }
+            g.bin.growTo(g.bin_start[n]);
+            g.occ.growTo(g.occ_start[n]);
+        }
+    }
+}
+
+
+// Propagates 't.root' over 'g' on top of the assignment of level 0, without changing the solver.
+// Every literal implied by a longer clause is implied by the dominator 'd' of the literals that
+// made the clause unit as well, which gives the hyper-binary resolvent '(~d | p)' and makes 'd' its
+// parent in the tree, so the dominators of later clauses are found without the clauses in between.
+// The resolvents go to 'out' (which belongs to the thread, as 's').
+void SimpSolver::probeRoot(const ProbeGraph& g, ProbeTask& t, ProbeScratch& s, vec<Lit>& out) const
+{
+    t.failed    = false;
+    t.props     = 0;
+    t.hbr_start = out.size();
+
+    auto assign = [&s](Lit p, Lit from){
+        s.val[toInt(p)]   = 1;
+        s.parent[var(p)]  = from;
+        s.depth[var(p)]   = from == lit_Undef ? 0 : s.depth[var(from)] + 1;
+        s.trail[s.trail_size++] = p; };
+    auto isTrue  = [&](Lit p){ return s.val[toInt(p)]  || value(p) == l_True;  };
+    auto isFalse = [&](Lit p){ return s.val[toInt(~p)] || value(p) == l_False; };
+    // The closest common dominator of 'p' and 'q' in the tree:
+    auto dominator = [&s](Lit p, Lit q){
+        while (p != q)
+            if (s.depth[var(p)] >= s.depth[var(q)])
+                p = s.parent[var(p)];
+            else
+                q = s.parent[var(q)];
+        return p; };
+
+    s.trail_size = 0;
+    assign(t.root, lit_Undef);
+    for (int qhead = 0; qhead < s.trail_size && !t.failed; qhead++){
+        Lit p = s.trail[qhead];
+        t.props++;
+
+        for (int i = g.bin_start[toInt(p)]; i < g.bin_start[toInt(p)+1]; i++){
+            Lit q = g.bin[i];
+            if (isTrue(q)) continue;
+            if (isFalse(q)){ t.failed = true; break; }
+            assign(q, p);
+        }
+
+        for (int i = g.occ_start[toInt(~p)]; i < g.occ_start[toInt(~p)+1] && !t.failed; i++){
+            const Clause& c = ca[g.occ[i]];
+            t.props++;
+
+            Lit unit  = lit_Undef;
+            int undef = 0;
+            for (int j = 0; j < c.size() && undef < 2; j++)
+                if (isTrue(c[j]))
+                    undef = 2;
+                else if (!isFalse(c[j])){
+                    unit = c[j];
+                    undef++; }
+
+            if (undef == 0)
+                t.failed = true;
+            else if (undef == 1){
+                Lit dom = lit_Undef;
+                for (int j = 0; j < c.size(); j++)
+                    if (s.val[toInt(~c[j])])
+                        dom = dom == lit_Undef ? ~c[j] : dominator(dom, ~c[j]);
+                out.push(dom);
+                out.push(unit);
+                assign(unit, dom);
+            }
+        }
+    }
+
+    for (int i = 0; i < s.trail_size; i++)
+        s.val[toInt(s.trail[i])] = 0;
+    if (t.failed)
+        out.shrink(out.size() - t.hbr_start);
+    t.hbr_end = out.size();
+}
+
+
+bool SimpSolver::hasBinary(Lit p, Lit q) const
+{
+    const vec<Watcher>& ws = watches[~p];
+    for (int i = 0; i < ws.size(); i++)
+        if (ws[i].blocker == q && ca[ws[i].cref].size() == 2 && ca[ws[i].cref].mark() == 0)
+            return true;
+    return false;
+}
+
+
+// Adds what a probe found. Every clause is implied by unit propagation on the clauses the probe
+// saw, which are still there, so it goes to the proof as it is.
+bool SimpSolver::commitProbe(const ProbeTask& t, const vec<Lit>& hbr)
+{
+    vec<Lit>& ps = add_tmp;
+    if (t.failed){
+        if (value(t.root) == l_False) return true;
+        failed_lits++;
+        ps.clear();
+        ps.push(~t.root);
+        if (proof) proof->addClause(ps);
+        return addClauseNoGroup_(ps);
+    }
+
+    for (int i = t.hbr_start; i < t.hbr_end; i += 2){
+        Lit d = hbr[i], p = hbr[i+1];
+        if (value(d) != l_Undef || value(p) != l_Undef || hasBinary(~d, p)) continue;
+        hbr_clauses++;
+        ps.clear();
+        ps.push(~d);
+        ps.push(p);
+        if (proof) proof->addClause(ps);
+        if (!addClauseNoGroup_(ps))
+            return false;
+    }
+    return true;
+}
+
+
+// Substitutes the literals of a strongly connected component of the binary implication graph,
+// which are all equivalent, by one of them (a frozen one if there is one, since frozen variables
+// stay).
+bool SimpSolver::substituteComponent(const vec<Lit>& scc)
+{
+    Lit rep  = lit_Undef;
+    int live = 0;
+    for (int i = 0; i < scc.size(); i++){
+        Var v = var(scc[i]);
+        if (isEliminated(v) || value(v) != l_Undef) continue;
+        live++;
+        if (rep == lit_Undef || (frozen[v] && !frozen[var(rep)]))
+            rep = scc[i];
+    }
+    if (live < 2) return true;
+
+    for (int i = 0; i < scc.size(); i++){
+        Var v = var(scc[i]);
+        if (v == var(rep) || isEliminated(v) || value(v) != l_Undef || frozen[v]) continue;
+        if (!substitute(v, rep ^ sign(scc[i])))
+            return false;
+    }
+    return true;
+}
+
+
+// Finds the strongly connected components of the binary implication graph (Tarjan's algorithm,
+// with an explicit stack) and substitutes each of them. The component of the negated literals
+// comes up as well; its variables are substituted by then. A component with a literal and its
+// negation makes the formula unsatisfiable.
+bool SimpSolver::substituteEquivalences()
+{
+    ProbeGraph g;
+    buildProbeGraph(g, false);
+
+    int      n = 2*nVars(), counter = 0;
+    vec<int> index(n, -1), low(n, 0), comp(n, -1);
+    vec<Lit> stack, scc;
+    vec<int> call, edge;          // The depth-first search: literals, and the next of their edges.
+    for (int r = 0; r < n && ok; r++){
+        if (index[r] >= 0 || g.bin_start[r] == g.bin_start[r+1]) continue;
+
+        index[r] = low[r] = counter++;
+        stack.push(toLit(r));
+        call.push(r);
+        edge.push(g.bin_start[r]);
+        while (call.size() > 0){
+            int u = call.last(), e = edge.last();
+            if (e < g.bin_start[u+1]){
+                int w = toInt(g.bin[e]);
+                edge.last()++;
+                if (index[w] < 0){
+                    index[w] = low[w] = counter++;
+                    stack.push(toLit(w));
+                    call.push(w);
+                    edge.push(g.bin_start[w]);
+                }else if (comp[w] < 0)
+                    low[u] = std::min(low[u], index[w]);
+                continue;
+            }
+
+            call.pop();
+            edge.pop();
+            if (call.size() > 0)
+                low[call.last()] = std::min(low[call.last()], low[u]);
+            if (low[u] != index[u]) continue;
+
+            scc.clear();
+            Lit p;
+            do {
+                p = stack.last();
+                stack.pop();
+                comp[toInt(p)] = u;
+                scc.push(p);
+            } while (toInt(p) != u);
+
+            for (int i = 0; i < scc.size(); i++)
+                if (comp[toInt(~scc[i])] == u){
+                    // 'p' implies '~p', so '~p' is a unit, and propagating it gives 'p':
+                    vec<Lit>& ps = add_tmp;
+                    ps.clear();
+                    ps.push(~scc[i]);
+                    if (proof) proof->addClause(ps);
+                    addClauseNoGroup_(ps);
+                    return ok = false; }
+
+            if (scc.size() > 1 && !substituteComponent(scc))
+                return false;
+        }
+    }
+    return ok;
+}
+
+
+// Failed-literal probing (on the roots of the binary implication graph, whose propagation covers
+// that of the literals they imply) and hyper-binary resolution, between two rounds of substituting
+// equivalent literals. The roots are probed in rounds, on 'probe_threads' threads, against the
+// clauses as they were at the start of the round; what each probe found is then added in the order
+// of the roots, so the result does not depend on the timing of the threads. Stops after the round
+// that used up the budget: 'probe_props', or 'probe_effort' per literal of the clauses if that is
+// less (probes that pay off stay well within a few propagations per literal, while on some
+// instances without failed literals probing would otherwise cost more than the search).
+bool SimpSolver::probe()
+{
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_Probe);
+    assert(decisionLevel() == 0);
+
+    int failed = failed_lits, hbr = hbr_clauses, substituted = substituted_vars;
+    if (!substituteEquivalences())
+        return false;
+
+    ProbeGraph g;
+    buildProbeGraph(g, true);
+    vec<Lit> roots;
+    for (int i = 0; i < 2*nVars(); i++){
+        Lit p = toLit(i);
+        if (!isEliminated(var(p)) && value(p) == l_Undef
+            && g.bin_start[i] < g.bin_start[i+1]                    // Implies something,
+            && g.bin_start[toInt(~p)] == g.bin_start[toInt(~p)+1])  // and is not implied.
+            roots.push(p);
+    }
+
+    const int max_round = 256;
+    vec<char> val   (probe_threads * 2*nVars(), 0);
+    vec<Lit>  lits  (probe_threads * 2*nVars(), lit_Undef);
+    vec<int>  depth (probe_threads * nVars(),   0);
+    vec<ProbeScratch> scratch(probe_threads);
+    for (int i = 0; i < probe_threads; i++){
+        scratch[i].val    = val   + i * 2*nVars();
+        scratch[i].trail  = lits  + i * 2*nVars();
+        scratch[i].parent = lits  + i * 2*nVars() + nVars();
+        scratch[i].depth  = depth + i * nVars(); }
+    vec<ProbeTask> tasks(max_round);
+    vec<Lit>       resolvents;
+
+    int64_t budget = std::min(probe_props, (int64_t)(probe_effort * (g.bin.size() + g.occ.size())));
+    int64_t props  = 0;
+    for (int r = 0; r < roots.size() && props < budget && ok && !asynch_interrupt;){
+        int n = 0;
+        for (; r < roots.size() && n < max_round; r++)
+            if (value(roots[r]) == l_Undef)
+                tasks[n++].root = roots[r];
+
+        // Small rounds are not worth starting threads for. Each thread appends its resolvents to
+        // those of the round when it is done (as in 'eliminateRound()'):
+        int nthreads = n < 64 ? 1 : probe_threads;
+        std::mutex       mtx;
+        std::atomic<int> next(0);
+        resolvents.clear();
+        auto work = [this, n, &g, &tasks, &next, &resolvents, &mtx](ProbeScratch& s){
+            vec<Lit> out;
+            vec<int> done;
+            for (int i; (i = next++) < n;){
+                probeRoot(g, tasks[i], s, out);
+                done.push(i); }
+
+            std::lock_guard<std::mutex> lock(mtx);
+            int base = resolvents.size();
+            for (int i = 0; i < out.size(); i++)
+                resolvents.push(out[i]);
+            for (int i = 0; i < done.size(); i++){
+                tasks[done[i]].hbr_start += base;
+                tasks[done[i]].hbr_end   += base; } };
+        std::vector<std::thread> threads;
+        for (int i = 1; i < nthreads; i++)
+            threads.emplace_back(work, std::ref(scratch[i]));
+        work(scratch[0]);
+        for (auto& t : threads)
+            t.join();
+
+        for (int i = 0; i < n && ok; i++){
+            props += tasks[i].props;
+            if (!commitProbe(tasks[i], resolvents))
+                return ok = false;
+        }
+    }
+
+    if (hbr_clauses > hbr && !substituteEquivalences())
+        return false;
+
+    if (verbosity >= 1 && failed_lits + hbr_clauses + substituted_vars > failed + hbr + substituted)
+        fprintf(stderr, "|  Probing:    %8d failed lits, %8d binaries, %8d substituted  |\n",
+                failed_lits - failed, hbr_clauses - hbr, substituted_vars - substituted);
+
+    return ok;
+}
+
+
 bool SimpSolver::eliminate(bool turn_off_elim)
 {
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_Eliminate);
+
     if (!simplify())
         return false;
     else if (!use_simplification)
         return true;
 
+    if (use_probe && !probe())
+        return false;
+
+    // The variables added by BVA take indices the user may count on for the next calls to 'newVar()',
+    // so it only runs when simplification is turned off afterwards:
+    if (use_bva && turn_off_elim && !boundedVariableAddition())
+        return false;
+
     // Main simplification loop:
     //
     while (n_touched > 0 || bwdsub_assigns < trail.size() || elim_heap.size() > 0){
@@ -622,6 +1769,11 @@ bool SimpSolver::eliminate(bool turn_off_elim)
             goto cleanup; }
 
         // fprintf(stderr, "  ## (time = %6.2f s) ELIM: vars = %d\n", cpuTime(), elim_heap.size());
+        if (elim_threads > 1 && use_elim && !use_asymm)
+            while (!elim_heap.empty() && !asynch_interrupt)
+                if (!eliminateRound() || !backwardSubsumptionCheck()){
+                    ok = false; goto cleanup; }
+
         for (int cnt = 0; !elim_heap.empty(); cnt++){
             Var elim = elim_heap.removeMin();
 
@@ -652,10 +1804,14 @@ bool SimpSolver::eliminate(bool turn_off_elim)
     }
  cleanup:
 
+    if (!ok && proof) proof->addEmptyClause();
+
     // If no more simplification is needed, free all simplification-related data structures:
     if (turn_off_elim){
         touched  .clear(true);
         occurs   .clear(true);
+        sub_watches.clear(true);
+        sub_mark .clear(true);
         n_occ    .clear(true);
         elim_heap.clear(true);
         subsumption_queue.clear(true);
@@ -684,6 +1840,7 @@ bool SimpSolver::eliminate(bool turn_off_elim)
 void SimpSolver::cleanUpClauses()
 {
     occurs.cleanAll();
+    sub_watches.cleanAll();
     auto j = std::remove_if(clauses.begin(), clauses.end(), [&] (Minisat::CRef const& ref) {
             return ca[ref].mark() != 0;
         }
@@ -709,6 +1866,15 @@ void SimpSolver::relocAll(ClauseAllocator& to)
         }
     }
 
+    // One-watch lists:
+    //
+    for (int i = 0; i < nVars(); i++)
+        for (int s = 0; s < 2; s++){
+            vec<CRef>& ws = sub_watches[mkLit(i, s)];
+            for (auto& w : ws)
+                ca.reloc(w, to);
+        }
+
     // Subsumption queue:
     //
     for (int i = 0; i < subsumption_queue.size(); i++)
@@ -722,6 +1888,9 @@ void SimpSolver::relocAll(ClauseAllocator& to)
 
 void SimpSolver::garbageCollect()
 {
+    double start_time = cpuTime();
+    ScopedPhase<ProfilingPolicy> phase(profile, phase_GarbageCollect);
+
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted());
@@ -734,4 +1903,25 @@ void SimpSolver::garbageCollect()
         fprintf(stderr, "|  Garbage collection:   %12d bytes => %12d bytes             |\n",
                ca.size()*ClauseAllocator::Unit_Size, to.size()*ClauseAllocator::Unit_Size);
     to.moveTo(ca);
+
+    garbage_collects++;
+    gc_time += cpuTime() - start_time;
+}
+
+
+void SimpSolver::registerStats(StatsRegistry& reg)
+{
+    Solver::registerStats(reg);
+    reg.add("eliminated_vars",  &eliminated_vars);
+    reg.add("merges",           &merges);
+    reg.add("asymm_lits",       &asymm_lits);
+    reg.add("elim_rounds",      &elim_rounds);
+    reg.add("eliminated_gates", &eliminated_gates);
+    reg.add("subsumed_clauses", &subsumed_clauses);
+    reg.add("strengthened_lits",&strengthened_lits);
+    reg.add("bva_vars",         &bva_vars);
+    reg.add("bva_clauses",      &bva_clauses);
+    reg.add("failed_lits",      &failed_lits);
+    reg.add("hbr_clauses",      &hbr_clauses);
+    reg.add("substituted_vars", &substituted_vars);
 }
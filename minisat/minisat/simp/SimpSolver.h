@@ -34,9 +34,12 @@ class SimpSolver : public Solver {
  public:
     // Constructor/Destructor:
     //
-    SimpSolver();
+    SimpSolver();                                 // Configured by the command-line options.
+    explicit SimpSolver(const SolverConfig& config);
     ~SimpSolver();
 
+    virtual void setConfig(const SolverConfig& config);
+
     // Problem specification:
     //
     Var     newVar    (bool polarity = true, bool dvar = true);
@@ -48,6 +51,11 @@ class SimpSolver : public Solver {
     bool    addClause_(      vec<Lit>& ps);
     bool    substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
+    // Clause groups (see 'Solver::push()'):
+    //
+    void    push      ();              // Open a new clause group; its activation literal is frozen.
+    void    addObservedVar(Var v);     // As 'Solver::addObservedVar()'; the variable is frozen.
+
     // Variable mode:
     // 
     void    setFrozen (Var v, bool b); // If a variable is frozen it will not be eliminated.
@@ -67,6 +75,10 @@ class SimpSolver : public Solver {
     //
     virtual void garbageCollect();
 
+    // Statistics export:
+    //
+    virtual void registerStats(StatsRegistry& reg);
+
 
     // Generate a (possibly simplified) DIMACS file:
     //
@@ -84,17 +96,38 @@ class SimpSolver : public Solver {
     int     clause_lim;        // Variables are not eliminated if it produces a resolvent with a length above this limit.
                                // -1 means no limit.
     int     subsumption_lim;   // Do not check if subsumption against a clause larger than this. -1 means no limit.
+    bool    use_fwd_sub;       // Check new clauses for subsumption by the old ones through one-watch lists (instead of
+                               // checking the old clauses of the variables they touch again).
     double  simp_garbage_frac; // A different limit for when to issue a GC during simplification (Also see 'garbage_frac').
 
     bool    use_asymm;         // Shrink clauses by asymmetric branching.
     bool    use_rcheck;        // Check if a clause is already implied. Prett costly, and subsumes subsumptions :)
     bool    use_elim;          // Perform variable elimination.
+    bool    use_gates;         // Only resolve the gate clauses against the others when a variable is defined by a gate.
+    bool    use_probe;         // Probe the roots of the binary implication graph and substitute equivalent literals.
+    int64_t probe_props;       // Budget of probing, in propagated literals and visited clauses...
+    double  probe_effort;      // ...but at most this many per literal of the clauses.
+    int     probe_threads;     // Threads probing the roots of a round.
+    bool    use_bva;           // Perform bounded variable addition before elimination (only in 'eliminate(true)').
+    int     bva_lim;           // BVA only adds a variable if it removes more than this many clauses.
+    int64_t bva_steps;         // Budget of BVA, in clause literals and matches visited.
+    int     elim_threads;      // Threads computing the resolvents of variable elimination. 1 means the sequential
+                               // elimination; more runs it in rounds of independent variables (ignored with 'use_asymm').
 
     // Statistics:
     //
     int     merges;
     int     asymm_lits;
     int     eliminated_vars;
+    int     elim_rounds;
+    int     eliminated_gates;
+    int     subsumed_clauses;
+    int     strengthened_lits;
+    int     bva_vars;
+    int     bva_clauses;
+    int     failed_lits;
+    int     hbr_clauses;
+    int     substituted_vars;
 
  protected:
 
@@ -116,11 +149,56 @@ class SimpSolver : public Solver {
         //     return c_x < c_y || c_x == c_y && x < y; }
     };
 
+    // Literals with more occurrences first:
+    struct BvaLt {
+        const vec<int>& n_occ;
+        explicit BvaLt(const vec<int>& no) : n_occ(no) {}
+        bool operator()(int p, int q) const { return n_occ[p] > n_occ[q]; } };
+
     struct ClauseDeleted {
         const ClauseAllocator& ca;
         explicit ClauseDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
         bool operator()(const CRef& cr) const { return ca[cr].mark() == 1; } };
 
+    // A variable of a round of parallel elimination, and what a thread found for it (a plain struct,
+    // so 'vec' may move it):
+    struct ElimTask {
+        Var       v;
+        bool      elim;        // The resolvents stay within 'grow' and 'clause_lim'.
+        bool      gate;        // 'v' is defined by a gate (see 'findGate()').
+        int       merges;
+        int       res_start;   // The non-tautological resolvents, each followed by 'lit_Undef', from
+        int       res_end;     // 'res_start' up to 'res_end' in the resolvents of the round.
+    };
+
+    // The binary implication graph and the longer clauses by literal, as read by probing:
+    struct ProbeGraph {
+        vec<int>  bin_start;   // Indexed by literal: the implications of 'p' are 'bin[bin_start[p]]' up to 'bin[bin_start[p+1]]'.
+        vec<Lit>  bin;
+        vec<int>  occ_start;   // As 'bin_start', for the clauses with 'p' in 'occ'.
+        vec<CRef> occ;
+    };
+
+    // A root of the binary implication graph, and what a thread of 'probe()' found for it (a plain
+    // struct, as 'ElimTask'):
+    struct ProbeTask {
+        Lit       root;
+        bool      failed;      // Propagating 'root' gives a conflict.
+        int64_t   props;       // Propagated literals and visited clauses.
+        int       hbr_start;   // Hyper-binary resolvents '(~d | p)', as pairs of 'd' and 'p', from
+        int       hbr_end;     // 'hbr_start' up to 'hbr_end' in the resolvents of the round.
+    };
+
+    // The assignment of a thread of 'probe()', with the implication tree of the root (a view of the
+    // buffers that 'probe()' allocates once for all rounds):
+    struct ProbeScratch {
+        char*     val;         // Indexed by literal: true under the root.
+        Lit*      trail;       // At most one literal per variable...
+        int       trail_size;  // ...and how many there are.
+        Lit*      parent;      // Indexed by variable: the dominator of its literal in the tree.
+        int*      depth;       // Indexed by variable.
+    };
+
     // Solver state:
     //
     int                 elimorder;
@@ -136,14 +214,21 @@ class SimpSolver : public Solver {
     vec<char>           eliminated;
     int                 bwdsub_assigns;
     int                 n_touched;
+    vec<ElimTask>       elim_tasks;
+    vec<char>           elim_mark;     // Variables sharing a clause with a variable of the current round.
+    OccLists<Lit, vec<CRef>, ClauseDeleted>
+                        sub_watches;   // Each clause under one of its literals (the least occurring when added).
+    vec<char>           sub_mark;      // Indexed by literal: in the clause being checked for subsumption.
 
     // Temporaries:
     //
     CRef                bwdsub_tmpunit;
+    vec<CRef>           bwdsub_cands;
 
     // Main internal methods:
     //
     lbool         solve_                   (bool do_simp = true, bool turn_off_simp = false);
+    bool          addClauseNoGroup_        (vec<Lit>& ps);
     bool          asymm                    (Var v, CRef cr);
     bool          asymmVar                 (Var v);
     void          updateElimHeap           (Var v);
@@ -151,7 +236,24 @@ class SimpSolver : public Solver {
     bool          merge                    (const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause);
     bool          merge                    (const Clause& _ps, const Clause& _qs, Var v, int& size);
     bool          backwardSubsumptionCheck (bool verbose = false);
+    bool          forwardSubsumptionCheck  (CRef cr, bool& changed);
+    Lit           subsumesMarked           (const Clause& c, const Clause& d) const;
+    Lit           subsumedByMarked         (const Clause& d) const;
+    void          markLits                 (const Clause& c, char m);
+    bool          boundedVariableAddition  ();
+    bool          probe                    ();
+    void          buildProbeGraph          (ProbeGraph& g, bool with_long) const;
+    void          probeRoot                (const ProbeGraph& g, ProbeTask& t, ProbeScratch& s, vec<Lit>& out) const;
+    bool          commitProbe              (const ProbeTask& t, const vec<Lit>& hbr);
+    bool          hasBinary                (Lit p, Lit q) const;
+    bool          substituteEquivalences   ();
+    bool          substituteComponent      (const vec<Lit>& scc);
+    bool          findGate                 (Var v, vec<CRef>& pos, vec<CRef>& neg, vec<Lit>& tmp, int& gpos, int& gneg) const;
     bool          eliminateVar             (Var v);
+    bool          eliminateRound           ();
+    void          elimResolvents           (ElimTask& t, vec<CRef>& pos, vec<CRef>& neg, vec<Lit>& out, vec<Lit>& tmp) const;
+    bool          commitElim               (const ElimTask& t, const vec<Lit>& resolvents);
+    void          storeElimClauses         (Var v, const vec<CRef>& pos, const vec<CRef>& neg);
     void          extendModel              ();
 
     void          removeClause             (CRef cr);
@@ -180,6 +282,8 @@ inline bool SimpSolver::addClause    (Lit p)                 { add_tmp.clear();
 inline bool SimpSolver::addClause    (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
 inline bool SimpSolver::addClause    (Lit p, Lit q, Lit r)   { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp); }
 inline void SimpSolver::setFrozen    (Var v, bool b) { frozen[v] = (char)b; if (use_simplification && !b) { updateElimHeap(v); } }
+inline void SimpSolver::push         ()              { Var v = newVar(true, false); setFrozen(v, true); group_lits.push(mkLit(v)); }
+inline void SimpSolver::addObservedVar(Var v)        { Solver::addObservedVar(v); setFrozen(v, true); }
 
 inline bool SimpSolver::solve        (                     bool do_simp, bool turn_off_simp)  { budgetOff(); assumptions.clear(); return solve_(do_simp, turn_off_simp) == l_True; }
 inline bool SimpSolver::solve        (Lit p       ,        bool do_simp, bool turn_off_simp)  { budgetOff(); assumptions.clear(); assumptions.push(p); return solve_(do_simp, turn_off_simp) == l_True; }
@@ -38,6 +38,7 @@ void Minisat::parseOptions(int& argc, char** argv, bool strict)
 
             for (int k = 0; !parsed_ok && k < Option::getOptionList().size(); k++){
                 parsed_ok = Option::getOptionList()[k]->parse(argv[i]);
+                if (parsed_ok) Option::getOptionList()[k]->given = true;
 
                 // fprintf(stderr, "checking %d: %s against flag <%s> (%s)\n", i, argv[i], Option::getOptionList()[k]->name, parsed_ok ? "ok" : "skip");
             }
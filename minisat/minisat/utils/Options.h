@@ -53,6 +53,7 @@ class Option
     const char* description;
     const char* category;
     const char* type_name;
+    bool        given;       // Set on the command line (by 'parseOptions()').
 
     static vec<Option*>& getOptionList () { static vec<Option*> options; return options; }
     static const char*&  getUsageString() { static const char* usage_str; return usage_str; }
@@ -73,6 +74,7 @@ class Option
     , description(desc_)
     , category   (cate_)
     , type_name  (type_)
+    , given      (false)
     {
         getOptionList().push(this);
     }
@@ -82,6 +84,7 @@ class Option
 
     virtual bool parse             (const char* str)      = 0;
     virtual void help              (bool verbose = false) = 0;
+    bool         isGiven           () const { return given; }
 
     friend  void parseOptions      (int& argc, char** argv, bool strict);
     friend  void printUsageAndExit (int  argc, char** argv, bool verbose);
@@ -230,6 +233,14 @@ class BoolOption : public Option
     virtual void help(bool verbose = false) override;
 };
 
+
+//==================================================================================================
+// Takes the value of an option into 'x' only if it was given on the command line, so what was set
+// before (such as a preset) stays unless the user asked for something else:
+
+template<class T, class O>
+inline void readIfGiven(T& x, const O& opt) { if (opt.isGiven()) x = opt; }
+
 //=================================================================================================
 }
 
@@ -0,0 +1,271 @@
+/***************************************************************************************[Profile.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Profile_h
+#define Minisat_Profile_h
+
+#include <stdio.h>
+
+#include <chrono>
+
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/mtl/Vec.h"
+#include "minisat/mtl/Sort.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define MINISAT_HAS_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define MINISAT_HAS_RDTSC
+#endif
+
+// Selects the profiling policy of the solvers: 0 = none (default), 1 = steady clock, 2 = time stamp
+// counter (falls back to the steady clock where 'rdtsc' is not available).
+#ifndef MINISAT_PROFILE
+#define MINISAT_PROFILE 0
+#endif
+
+namespace Minisat {
+
+//=================================================================================================
+// Phases and counters:
+
+
+enum Phase {
+    phase_Propagate,
+    phase_Analyze,
+    phase_ReduceDB,
+    phase_Simplify,
+    phase_GarbageCollect,
+    phase_Eliminate,
+    phase_Subsume,
+    phase_Bva,
+    phase_Probe,
+    phase_Vivify,
+    phase_Count
+};
+
+enum Counter {
+    // Also kept per watch list:
+    ctr_Watchers,           // Watchers visited by 'propagate()'.
+    ctr_ClauseVisits,       // Clauses dereferenced by 'propagate()' (the blocker was not true).
+    ctr_WatchSearches,      // Searches for a replacement watch (the other watch was not true).
+    ctr_WatchMoves,         // Searches that found a new watch.
+    ctr_ListCount,
+
+    ctr_ResolvedLits = ctr_ListCount,  // Literals of reason clauses visited by 'analyze()'.
+    ctr_Count
+};
+
+static inline const char* phaseName(int p)
+{
+    static const char* names[phase_Count] = { "propagate", "analyze", "reduceDB", "simplify", "garbageCollect", "eliminate", "subsume", "bva", "probe", "vivify" };
+    return names[p];
+}
+
+static inline const char* counterName(int c)
+{
+    static const char* names[ctr_Count] = { "watchers", "clause_visits", "watch_searches", "watch_moves", "resolved_lits" };
+    return names[c];
+}
+
+
+//=================================================================================================
+// Policies -- a clock, read by 'now()' in ticks that 'secondsPerTick()' converts:
+
+
+struct NoProfiling {
+    static const bool enabled = false;
+};
+
+struct ClockProfiling {
+    static const bool enabled = true;
+    static uint64_t now() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+    static double   secondsPerTick() { return 1e-9; }
+};
+
+#ifdef MINISAT_HAS_RDTSC
+struct TscProfiling {
+    static const bool enabled = true;
+    static uint64_t now() { return __rdtsc(); }
+    static double   secondsPerTick() {
+        static const double spt = calibrate();
+        return spt; }
+
+private:
+    // Measures the counter against the steady clock once, for about 10 milliseconds:
+    static double calibrate() {
+        uint64_t t0 = ClockProfiling::now(), c0 = now(), t1;
+        do t1 = ClockProfiling::now(); while (t1 - t0 < 10000000);
+        return (t1 - t0) * 1e-9 / (double)(now() - c0); }
+};
+#else
+typedef ClockProfiling TscProfiling;
+#endif
+
+#if MINISAT_PROFILE == 1
+typedef ClockProfiling ProfilingPolicy;
+#elif MINISAT_PROFILE == 2
+typedef TscProfiling   ProfilingPolicy;
+#else
+typedef NoProfiling    ProfilingPolicy;
+#endif
+
+
+//=================================================================================================
+// PhaseProfiler -- accumulated time and calls per phase, and hot-path counters:
+//
+// Phases nest: the time of a phase includes the phases it calls (e.g. 'simplify' includes its calls
+// to 'propagate'). The counters below 'ctr_ListCount' are also charged to the watch list announced
+// by the last call to 'watchList()', which gives a histogram of the watch list lengths seen by
+// propagation and the literals whose lists cost the most. With 'NoProfiling' every member is an
+// empty inline function or a constant, so instrumented code compiles to nothing.
+
+template<class Policy>
+class PhaseProfiler {
+    struct ListStats {
+        uint64_t scans, max_size;
+        uint64_t counts[ctr_ListCount];
+    };
+    enum { hist_Size = 32 };
+
+    uint64_t       ticks [phase_Count];
+    uint64_t       ncalls[phase_Count];
+    uint64_t       counts[ctr_Count];
+    vec<ListStats> lists;                     // Indexed by the literal whose watches are scanned.
+    int            current;
+    uint64_t       hist_scans   [hist_Size];  // Scans of lists with a size in [2^(i-1), 2^i).
+    uint64_t       hist_watchers[hist_Size];  // Watchers in those lists.
+
+    struct MoreWatchers {
+        const vec<ListStats>& lists;
+        MoreWatchers(const vec<ListStats>& l) : lists(l) {}
+        bool operator()(int x, int y) const { return lists[x].counts[ctr_Watchers] > lists[y].counts[ctr_Watchers]; }
+    };
+
+    static int  bucket   (uint64_t size) { int b = 0; while (size > 0 && b < hist_Size-1) size >>= 1, b++; return b; }
+
+public:
+    static const bool enabled = true;
+
+    PhaseProfiler() { clear(); }
+
+    void     clear  () {
+        for (int p = 0; p < phase_Count; p++) ticks[p] = ncalls[p] = 0;
+        for (int c = 0; c < ctr_Count; c++)   counts[c] = 0;
+        for (int i = 0; i < hist_Size; i++)   hist_scans[i] = hist_watchers[i] = 0;
+        lists.clear();
+        current = 0; }
+
+    void     record (Phase p, uint64_t t) { ticks[p] += t; ncalls[p]++; }
+    void     count  (Counter c, uint64_t n = 1) {
+        counts[c] += n;
+        if (c < ctr_ListCount) lists[current].counts[c] += n; }
+
+    // 'propagate()' starts scanning the watch list of literal 'lit' (as given by 'toInt()'):
+    void     watchList(int lit, int size) {
+        if (lit >= lists.size()){
+            lists.growTo(lit + 1, ListStats()); }
+        ListStats& l = lists[lit];
+        l.scans++;
+        if ((uint64_t)size > l.max_size) l.max_size = size;
+        hist_scans[bucket(size)]++;
+        hist_watchers[bucket(size)] += size;
+        current = lit; }
+
+    double   seconds(int p) const { return ticks[p] * Policy::secondsPerTick(); }
+    uint64_t calls  (int p) const { return ncalls[p]; }
+    uint64_t counter(int c) const { return counts[c]; }
+
+    void     print  (FILE* out, int top = 10) const {
+        for (int p = 0; p < phase_Count; p++)
+            if (ncalls[p] > 0)
+                fprintf(out, "time %-16s : %-12.3f s (%" PRIu64 " calls)\n", phaseName(p), seconds(p), ncalls[p]);
+        for (int c = 0; c < ctr_Count; c++)
+            if (counts[c] > 0)
+                fprintf(out, "%-21s : %" PRIu64 "\n", counterName(c), counts[c]);
+        if (counts[ctr_Watchers] == 0)
+            return;
+
+        fprintf(out, "watch list sizes      :   scans         watchers\n");
+        for (int i = 0; i < hist_Size; i++)
+            if (hist_scans[i] > 0){
+                uint64_t lo = i == 0 ? 0 : (uint64_t)1 << (i-1), hi = i == 0 ? 0 : ((uint64_t)1 << i) - 1;
+                fprintf(out, "  %8" PRIu64 " - %-8" PRIu64 " : %-12" PRIu64 "  %-12" PRIu64 " (%5.2f %%)\n",
+                        lo, hi, hist_scans[i], hist_watchers[i], hist_watchers[i] * 100.0 / counts[ctr_Watchers]); }
+
+        vec<int> hot;
+        for (int i = 0; i < lists.size(); i++)
+            if (lists[i].counts[ctr_Watchers] > 0)
+                hot.push(i);
+        sort(hot, MoreWatchers(lists));
+        if (hot.size() > top) hot.shrink(hot.size() - top);
+
+        fprintf(out, "hot literals          :   scans     avg size  max size   watchers      blocked   searches   moves\n");
+        for (int i = 0; i < hot.size(); i++){
+            const ListStats& l = lists[hot[i]];
+            uint64_t w = l.counts[ctr_Watchers];
+            fprintf(out, "  %-19d : %-10" PRIu64 " %-9.1f %-10" PRIu64 " %-12" PRIu64 " %5.1f %%   %-10" PRIu64 " %" PRIu64 "\n",
+                    (hot[i] & 1) ? -((hot[i] >> 1) + 1) : (hot[i] >> 1) + 1, l.scans, (double)w / l.scans, l.max_size, w, (w - l.counts[ctr_ClauseVisits]) * 100.0 / w,
+                    l.counts[ctr_WatchSearches], l.counts[ctr_WatchMoves]); }
+    }
+};
+
+template<>
+class PhaseProfiler<NoProfiling> {
+public:
+    static const bool enabled = false;
+
+    void     clear    () {}
+    void     record   (Phase, uint64_t) {}
+    void     count    (Counter, uint64_t = 1) {}
+    void     watchList(int, int) {}
+    double   seconds  (int) const { return 0; }
+    uint64_t calls    (int) const { return 0; }
+    uint64_t counter  (int) const { return 0; }
+    void     print    (FILE*, int = 10) const {}
+};
+
+
+//=================================================================================================
+// ScopedPhase -- charges the lifetime of the object to a phase:
+
+
+template<class Policy>
+class ScopedPhase {
+    PhaseProfiler<Policy>& prof;
+    Phase                  phase;
+    uint64_t               start;
+
+public:
+    ScopedPhase(PhaseProfiler<Policy>& p, Phase ph) : prof(p), phase(ph), start(Policy::now()) {}
+    ~ScopedPhase() { prof.record(phase, Policy::now() - start); }
+};
+
+template<>
+class ScopedPhase<NoProfiling> {
+public:
+    ScopedPhase(PhaseProfiler<NoProfiling>&, Phase) {}
+};
+
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,160 @@
+/****************************************************************************************[Stats.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minisat/utils/Stats.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Constructor/Destructor:
+
+
+StatsRegistry::StatsRegistry() :
+    out        (NULL)
+  , format     (fmt_JSON)
+  , interval   (0)
+  , start_time (realTime())
+  , next_time  (0)
+  , header_done(false)
+{}
+
+
+StatsRegistry::~StatsRegistry()
+{
+    for (int i = 0; i < entries.size(); i++){
+        free(entries[i]->name);
+        delete entries[i]; }
+}
+
+
+//=================================================================================================
+// Registration:
+
+
+StatsRegistry::Entry* StatsRegistry::lookup(const char* name)
+{
+    for (int i = 0; i < entries.size(); i++)
+        if (strcmp(entries[i]->name, name) == 0)
+            return entries[i];
+    return NULL;
+}
+
+
+StatsRegistry::Entry* StatsRegistry::push(const char* name, int kind)
+{
+    Entry* e = lookup(name);
+    if (e == NULL){
+        size_t len = strlen(name) + 1;
+        e = new Entry;
+        e->name = (char*)malloc(len);
+        memcpy(e->name, name, len);
+        entries.push(e);
+    }
+    e->kind  = kind;
+    e->ptr   = NULL;
+    e->value = 0;
+    e->func  = nullptr;
+    return e;
+}
+
+
+void StatsRegistry::add(const char* name, const uint64_t* v) { push(name, kind_Uint64)->ptr = v; }
+void StatsRegistry::add(const char* name, const int*      v) { push(name, kind_Int   )->ptr = v; }
+void StatsRegistry::add(const char* name, const double*   v) { push(name, kind_Double)->ptr = v; }
+void StatsRegistry::add(const char* name, std::function<double()> f) { push(name, kind_Func)->func = f; }
+
+
+void StatsRegistry::set(const char* name, double v)
+{
+    Entry* e = lookup(name);
+    if (e == NULL || e->kind != kind_Value)
+        e = push(name, kind_Value);
+    e->value = v;
+}
+
+
+//=================================================================================================
+// Output:
+
+
+void StatsRegistry::open(FILE* out_, Format fmt, double interval_)
+{
+    out         = out_;
+    format      = fmt;
+    interval    = interval_;
+    start_time  = realTime();
+    next_time   = start_time + interval;
+    header_done = false;
+}
+
+
+// Counts computed as doubles are written as integers, everything else with 6 significant digits.
+// NaN and infinity (as a rate over no time) have no JSON number, so they are written as 'null', or
+// as an empty field in CSV:
+static void writeDouble(FILE* out, double v, StatsRegistry::Format fmt)
+{
+    if (!isfinite(v)){
+        if (fmt == StatsRegistry::fmt_JSON) fprintf(out, "null");
+    }else if (v == floor(v) && fabs(v) < 1e15)
+        fprintf(out, "%.0f", v);
+    else
+        fprintf(out, "%.6g", v);
+}
+
+
+void StatsRegistry::write(const char* event)
+{
+    if (out == NULL) return;
+
+    double now = realTime();
+    next_time  = now + interval;
+
+    if (format == fmt_CSV && !header_done){
+        fprintf(out, "event,time");
+        for (int i = 0; i < entries.size(); i++)
+            fprintf(out, ",%s", entries[i]->name);
+        fprintf(out, "\n");
+        header_done = true;
+    }
+
+    if (format == fmt_JSON)
+        fprintf(out, "{\"event\":\"%s\",\"time\":%.6f", event, now - start_time);
+    else
+        fprintf(out, "%s,%.6f", event, now - start_time);
+
+    for (int i = 0; i < entries.size(); i++){
+        const Entry& e = *entries[i];
+        if (format == fmt_JSON)
+            fprintf(out, ",\"%s\":", e.name);
+        else
+            fprintf(out, ",");
+
+        switch (e.kind){
+        case kind_Uint64: fprintf(out, "%" PRIu64, *(const uint64_t*)e.ptr); break;
+        case kind_Int:    fprintf(out, "%d",       *(const int*)e.ptr);      break;
+        case kind_Double: writeDouble(out, *(const double*)e.ptr, format);   break;
+        case kind_Func:   writeDouble(out, e.func(), format);                break;
+        default:          writeDouble(out, e.value, format);                 break;
+        }
+    }
+    fprintf(out, format == fmt_JSON ? "}\n" : "\n");
+    fflush(out);
+}
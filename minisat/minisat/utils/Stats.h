@@ -0,0 +1,98 @@
+/*****************************************************************************************[Stats.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Stats_h
+#define Minisat_Stats_h
+
+#include <stdio.h>
+
+#include <functional>
+
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/mtl/Vec.h"
+#include "minisat/utils/System.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// StatsRegistry -- named statistics, written as machine readable records:
+//
+// Counters are registered by address and only read when a record is written, so the solver's hot
+// paths are not affected. Each record is either one JSON object per line, or one CSV row (the
+// header is written before the first row). Every record starts with the fields "event" (what
+// triggered it, e.g. "interval" or "final") and "time" (wall-clock seconds since 'open()').
+
+class StatsRegistry {
+public:
+    enum Format { fmt_JSON, fmt_CSV };
+
+    StatsRegistry();
+    ~StatsRegistry();
+
+    // Registration (names should be unique; register everything before the first record):
+    //
+    void    add   (const char* name, const uint64_t* v);
+    void    add   (const char* name, const int*      v);
+    void    add   (const char* name, const double*   v);
+    void    add   (const char* name, std::function<double()> f);  // Evaluated for each record.
+    void    set   (const char* name, double v);                   // A value kept by the registry.
+
+    // Output:
+    //
+    void    open  (FILE* out, Format fmt, double interval = 0);   // 'interval' in seconds, 0 = off.
+    void    write (const char* event);
+    void    tick  ();                                             // Write an "interval" record if due.
+
+    bool    isOpen() const { return out != NULL; }
+
+private:
+    enum { kind_Uint64, kind_Int, kind_Double, kind_Func, kind_Value };
+    struct Entry {
+        char*                   name;
+        int                     kind;
+        const void*             ptr;
+        double                  value;
+        std::function<double()> func;
+    };
+
+    vec<Entry*> entries;
+    FILE*       out;
+    Format      format;
+    double      interval;
+    double      start_time;
+    double      next_time;
+    bool        header_done;
+
+    Entry*  lookup(const char* name);
+    Entry*  push  (const char* name, int kind);
+};
+
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline void StatsRegistry::tick()
+{
+    if (interval > 0 && realTime() >= next_time)
+        write("interval");
+}
+
+
+//=================================================================================================
+}
+
+#endif
@@ -90,6 +90,23 @@ double Minisat::memUsed(void) {
     return (double)t.max_size_in_use / (1024*1024); }
 double Minisat::memUsedPeak(void) { return memUsed(); }
 
+#elif defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+
+static bool memReadCounters(PROCESS_MEMORY_COUNTERS& pmc) {
+    return GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)) != 0; }
+
+double Minisat::memUsed(void) {
+    PROCESS_MEMORY_COUNTERS pmc;
+    return memReadCounters(pmc) ? (double)pmc.WorkingSetSize / (1024*1024) : 0; }
+double Minisat::memUsedPeak(void) {
+    PROCESS_MEMORY_COUNTERS pmc;
+    return memReadCounters(pmc) ? (double)pmc.PeakWorkingSetSize / (1024*1024) : 0; }
+
 #else
 double Minisat::memUsed() { return 0; }
 double Minisat::memUsedPeak() { return 0; }
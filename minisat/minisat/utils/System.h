@@ -25,6 +25,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <fpu_control.h>
 #endif
 
+#include <chrono>
+
 #include "minisat/mtl/IntTypes.h"
 
 //-------------------------------------------------------------------------------------------------
@@ -32,6 +34,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 namespace Minisat {
 
 static inline double cpuTime(void); // CPU-time in seconds.
+static inline double realTime(void); // Wall-clock time in seconds (from an arbitrary starting point).
 extern double memUsed();            // Memory in mega bytes (returns 0 for unsupported architectures).
 extern double memUsedPeak();        // Peak-memory in mega bytes (returns 0 for unsupported architectures).
 
@@ -57,4 +60,7 @@ static inline double Minisat::cpuTime(void) {
 
 #endif
 
+static inline double Minisat::realTime(void) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
 #endif
@@ -0,0 +1,94 @@
+/**************************************************************************************[UnitTest.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_UnitTest_h
+#define Minisat_UnitTest_h
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "minisat/core/Solver.h"
+
+//=================================================================================================
+// Helpers of the unit tests -- each test is a program that exits with 1 at the first failed check:
+
+#define CHECK(cond) \
+    do { if (!(cond)){ fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while (0)
+
+namespace Minisat {
+
+// A small xorshift generator, so the tests do not depend on the C library's 'rand()':
+class TestRandom {
+    uint64_t state;
+public:
+    explicit TestRandom(uint64_t seed) : state(seed * 2685821657736338717ULL + 1) {}
+    uint32_t next () { state ^= state >> 12; state ^= state << 25; state ^= state >> 27; return (uint32_t)((state * 2685821657736338717ULL) >> 32); }
+    int      range(int n) { return (int)(next() % (uint32_t)n); }   // In [0, n).
+    Lit      lit  (int vars) { return mkLit(range(vars), next() & 1); }
+};
+
+// A random clause of 'size' literals over variables '0..vars-1' (distinct variables):
+static inline void randomClause(TestRandom& rnd, int vars, int size, vec<Lit>& ps)
+{
+    ps.clear();
+    while (ps.size() < size){
+        Lit p = rnd.lit(vars);
+        int i;
+        for (i = 0; i < ps.size() && var(ps[i]) != var(p); i++);
+        if (i == ps.size()) ps.push(p);
+    }
+}
+
+// The answer of a fresh solver for 'clauses' over 'vars' variables, under 'assumps':
+static inline bool freshSolve(int vars, const vec<vec<Lit> >& clauses, const vec<Lit>& assumps)
+{
+    Solver S;
+    S.verbosity = 0;
+    while (S.nVars() < vars) S.newVar();
+    for (int i = 0; i < clauses.size(); i++)
+        S.addClause(clauses[i]);
+    return S.solve(assumps);
+}
+
+// The model of 'S' satisfies 'clauses' and 'assumps':
+static inline bool modelSatisfies(const Solver& S, const vec<vec<Lit> >& clauses, const vec<Lit>& assumps)
+{
+    for (int i = 0; i < assumps.size(); i++)
+        if (S.modelValue(assumps[i]) != l_True) return false;
+    for (int i = 0; i < clauses.size(); i++){
+        int k;
+        for (k = 0; k < clauses[i].size() && S.modelValue(clauses[i][k]) != l_True; k++);
+        if (k == clauses[i].size()) return false; }
+    return true;
+}
+
+// The final conflict of 'S' is a set of negated assumptions that is itself unsatisfiable:
+static inline bool conflictValid(const Solver& S, int vars, const vec<vec<Lit> >& clauses, const vec<Lit>& assumps)
+{
+    vec<Lit> core;
+    for (int i = 0; i < S.conflict.size(); i++){
+        Lit p = S.conflict[i];
+        int k;
+        for (k = 0; k < assumps.size() && assumps[k] != ~p; k++);
+        if (k == assumps.size()) return false;
+        core.push(~p); }
+    return !freshSolve(vars, clauses, core);
+}
+
+}
+
+#endif
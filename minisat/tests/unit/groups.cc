@@ -0,0 +1,144 @@
+/****************************************************************************************[groups.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "UnitTest.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Clause groups: 'push()', 'pop()' and the final conflict under open groups.
+
+
+// The conflict only has (negated) assumptions of the user, never an activation literal of a group:
+static void checkConflict(const Solver& S, int user_vars, const vec<Lit>& assumps)
+{
+    for (int i = 0; i < S.conflict.size(); i++){
+        CHECK(var(S.conflict[i]) < user_vars);
+        int k;
+        for (k = 0; k < assumps.size() && assumps[k] != ~S.conflict[i]; k++);
+        CHECK(k < assumps.size());
+    }
+}
+
+
+static void basic()
+{
+    Solver S;
+    S.verbosity = 0;
+    Lit a = mkLit(S.newVar()), b = mkLit(S.newVar()), c = mkLit(S.newVar());
+    S.addClause(a, b);
+
+    // UNSAT under a group, SAT again after popping it:
+    S.push();
+    S.addClause(~a);
+    S.addClause(~b);
+    CHECK(S.nGroups() == 1);
+    CHECK(!S.solve());
+    CHECK(S.okay());
+    checkConflict(S, 3, vec<Lit>());
+    S.pop();
+    CHECK(S.nGroups() == 0);
+    CHECK(S.solve());
+    CHECK(S.modelValue(a) == l_True || S.modelValue(b) == l_True);
+
+    // UNSAT under an assumption and a group: the conflict is the assumption alone:
+    S.push();
+    S.addClause(~c, ~a);
+    S.addClause(~c, ~b);
+    vec<Lit> assumps;
+    assumps.push(c);
+    CHECK(!S.solve(assumps));
+    checkConflict(S, 3, assumps);
+    CHECK(S.conflict.size() == 1 && S.conflict[0] == ~c);
+    CHECK(S.solve(~c));
+
+    // Nested groups: popping the inner one keeps the outer one:
+    S.push();
+    S.addClause(~a);
+    CHECK(S.solve());
+    CHECK(S.modelValue(b) == l_True);
+    CHECK(!S.solve(c));
+    S.pop();
+    CHECK(!S.solve(c));
+    S.pop();
+    CHECK(S.solve(c));
+    CHECK(S.okay());
+}
+
+
+// Random pushes, pops, clauses and assumptions, checked against a fresh solver of the clauses
+// that are active at the time:
+static void randomized(uint64_t seed)
+{
+    const int  vars = 12;
+    TestRandom rnd(seed);
+    Solver     S;
+    S.verbosity = 0;
+    while (S.nVars() < vars) S.newVar();
+
+    vec<vec<Lit> > clauses;      // The active clauses.
+    vec<int>       group_start;  // Where the clauses of each open group start in 'clauses'.
+    vec<Lit>       ps, assumps;
+    for (int step = 0; step < 300; step++){
+        int op = rnd.range(10);
+        if (op < 2){
+            S.push();
+            group_start.push(clauses.size());
+        }else if (op < 3 && group_start.size() > 0){
+            S.pop();
+            clauses.shrink(clauses.size() - group_start.last());
+            group_start.pop();
+        }else if (op < 6){
+            randomClause(rnd, vars, rnd.range(8) == 0 ? 1 : 2 + rnd.range(3), ps);
+            S.addClause(ps);
+            clauses.push();
+            ps.copyTo(clauses.last());
+        }else{
+            assumps.clear();
+            for (int k = rnd.range(4); k > 0; k--)
+                assumps.push(rnd.lit(vars));
+            bool expect = freshSolve(vars, clauses, assumps);
+            bool result = S.solve(assumps);
+            CHECK(result == expect);
+            if (result)
+                CHECK(modelSatisfies(S, clauses, assumps));
+            else{
+                checkConflict(S, vars, assumps);
+                CHECK(conflictValid(S, vars, clauses, assumps));
+            }
+        }
+        // Clauses outside of groups are permanent, so the solver may become contradictory for good
+        // (but only then):
+        if (!S.okay()){
+            vec<vec<Lit> > permanent;
+            for (int i = 0; i < (group_start.size() > 0 ? group_start[0] : clauses.size()); i++){
+                permanent.push();
+                clauses[i].copyTo(permanent.last()); }
+            CHECK(!freshSolve(vars, permanent, vec<Lit>()));
+            break; }
+    }
+}
+
+
+int main()
+{
+    basic();
+    for (uint64_t seed = 1; seed <= 200; seed++)
+        randomized(seed);
+    printf("groups: OK\n");
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*************************************************************************************[portfolio.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "UnitTest.h"
+#include "minisat/core/Portfolio.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Portfolio: repeated runs in both modes, with the first solver (the one of the caller) still
+// usable on its own afterwards, and deterministic runs that repeat exactly.
+
+
+// 'holes + 1' pigeons in 'holes' holes (UNSAT, and hard enough for every solver to take part):
+static void pigeonHole(Portfolio& P, int holes)
+{
+    vec<Lit> ps;
+    while (P.nVars() < (holes + 1) * holes) P.newVar();
+    for (int i = 0; i <= holes; i++){
+        ps.clear();
+        for (int j = 0; j < holes; j++)
+            ps.push(mkLit(i * holes + j));
+        P.addClause_(ps); }
+    for (int j = 0; j < holes; j++)
+        for (int i = 0; i <= holes; i++)
+            for (int k = i+1; k <= holes; k++){
+                ps.clear();
+                ps.push(~mkLit(i * holes + j));
+                ps.push(~mkLit(k * holes + j));
+                P.addClause_(ps); }
+}
+
+
+static void solveTwice(bool deterministic)
+{
+    Solver    S;
+    Portfolio P(S, 4, deterministic);
+    P.setConfig(SolverConfig());
+    pigeonHole(P, 7);
+
+    // (A solver that lost the first run must not stay interrupted.)
+    CHECK(P.solve() == l_False);
+    CHECK(P.winner >= 0);
+    CHECK(P.solve() == l_False);
+    CHECK(P.winner >= 0);
+    vec<Lit> dummy;
+    CHECK(S.solveLimited(dummy) == l_False);
+}
+
+
+// A satisfiable formula: the model of the winner ends up in the first solver.
+static void satisfiable(bool deterministic, uint64_t seed)
+{
+    const int  vars = 150;
+    TestRandom rnd(seed);
+    Solver     S;
+    Portfolio  P(S, 4, deterministic);
+    P.setConfig(SolverConfig());
+    while (P.nVars() < vars) P.newVar();
+
+    vec<vec<Lit> > clauses;
+    vec<Lit>       ps;
+    for (int i = 0; i < 550; i++){
+        randomClause(rnd, vars, 3, ps);
+        clauses.push();
+        ps.copyTo(clauses.last());
+        P.addClause_(ps); }
+    bool expect = freshSolve(vars, clauses, vec<Lit>());
+    for (int run = 0; run < 2; run++){
+        lbool ret = P.solve();
+        CHECK(ret == (expect ? l_True : l_False));
+        if (expect)
+            CHECK(modelSatisfies(S, clauses, vec<Lit>()));
+    }
+}
+
+
+// Two deterministic runs from scratch take the same course, whatever the threads interleave:
+static void repeatable()
+{
+    uint64_t conflicts[2], epochs[2], imported[2];
+    int      winner[2];
+    for (int run = 0; run < 2; run++){
+        Solver    S;
+        Portfolio P(S, 4, true);
+        P.setConfig(SolverConfig());
+        pigeonHole(P, 7);
+        CHECK(P.solve() == l_False);
+        conflicts[run] = 0;
+        for (int i = 0; i < P.nSolvers(); i++)
+            conflicts[run] += P.solver(i).conflicts;
+        epochs[run]   = P.epochs;
+        imported[run] = P.imported;
+        winner[run]   = P.winner;
+    }
+    CHECK(conflicts[0] == conflicts[1]);
+    CHECK(epochs[0]    == epochs[1]);
+    CHECK(imported[0]  == imported[1]);
+    CHECK(winner[0]    == winner[1]);
+}
+
+
+int main()
+{
+    solveTwice(true);
+    solveTwice(false);
+    for (uint64_t seed = 1; seed <= 10; seed++){
+        satisfiable(true,  seed);
+        satisfiable(false, seed); }
+    repeatable();
+    printf("portfolio: OK\n");
+    return 0;
+}
@@ -0,0 +1,181 @@
+/************************************************************************************[propagator.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "UnitTest.h"
+#include "minisat/core/ExternalPropagator.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// ExternalPropagator: at-most-one constraints propagated by a propagator, checked against the same
+// constraints encoded as pairwise clauses.
+
+
+// At most one variable of each group is true. The propagator keeps its own copy of the assignment
+// of the group variables (with its own decision levels), so any notification the solver gets wrong
+// shows up as an inconsistency:
+class AtMostOne : public ExternalPropagator {
+    vec<vec<Lit> > groups;
+    vec<int>       group_of;    // Per variable: its group, or -1.
+    vec<lbool>     val;         // The assignment, as notified (or as implied by 'propagate()').
+    vec<Lit>       reason_of;   // Per variable 'y' implied false: the true 'x' of its group.
+    vec<Lit>       trail;
+    vec<int>       trail_lim;
+    int            qhead;       // The true literal of 'trail' whose group is being scanned...
+    int            qpos;        // ...and the position in the group.
+    Lit            conflict;    // The last literal returned that was already false.
+
+    void assign(Lit p){ val[var(p)] = lbool(!sign(p)); trail.push(p); }
+
+public:
+    int reasons, conflicts, backtracks;  // Reasons asked for by conflict analysis, conflicts above the root, backtracks.
+
+    AtMostOne(int vars) : qhead(0), qpos(0), conflict(lit_Undef), reasons(0), conflicts(0), backtracks(0) {
+        group_of.growTo(vars, -1); val.growTo(vars, l_Undef); reason_of.growTo(vars, lit_Undef); }
+
+    void addGroup(const vec<Lit>& g){
+        for (int i = 0; i < g.size(); i++)
+            group_of[var(g[i])] = groups.size();
+        groups.push();
+        g.copyTo(groups.last()); }
+
+    void notifyAssignment(Lit p, bool is_fixed){
+        CHECK(!is_fixed || trail_lim.size() == 0);
+        if (val[var(p)] == l_Undef)
+            assign(p);
+        else
+            CHECK(val[var(p)] == lbool(!sign(p)));   // (Implied by this propagator.)
+    }
+
+    void notifyNewDecisionLevel(){ trail_lim.push(trail.size()); }
+
+    void notifyBacktrack(int new_level){
+        CHECK(new_level < trail_lim.size());
+        backtracks++;
+        for (int i = trail_lim[new_level]; i < trail.size(); i++)
+            val[var(trail[i])] = l_Undef;
+        trail.shrink(trail.size() - trail_lim[new_level]);
+        trail_lim.shrink(trail_lim.size() - new_level);
+        if (qhead > trail.size()){
+            qhead = trail.size();
+            qpos  = 0; }
+    }
+
+    Lit propagate(){
+        for (; qhead < trail.size(); qhead++, qpos = 0){
+            Lit x = trail[qhead];
+            if (sign(x)) continue;
+            const vec<Lit>& g = groups[group_of[var(x)]];
+            for (; qpos < g.size(); qpos++){
+                Lit y = g[qpos];
+                if (y == x || val[var(y)] == l_False) continue;
+                reason_of[var(y)] = x;
+                if (val[var(y)] == l_Undef){
+                    assign(~y);
+                    return ~y; }
+                conflict = ~y;
+                return ~y;
+            }
+        }
+        return lit_Undef;
+    }
+
+    void addReasonClause(Lit p, vec<Lit>& out_clause){
+        Lit x = reason_of[var(p)];
+        CHECK(sign(p) && x != lit_Undef && val[var(x)] == l_True);
+        if (p == conflict){
+            CHECK(val[var(p)] == l_True);
+            if (trail_lim.size() > 0) conflicts++;
+            conflict = lit_Undef;
+        }else{
+            CHECK(val[var(p)] == l_False);
+            reasons++; }
+        out_clause.push(p);
+        out_clause.push(~x);
+    }
+};
+
+
+static int reasons = 0, conflicts = 0, backtracks = 0;
+
+// Exactly-one groups and random clauses, with the at-most-one part in a propagator. A sequence of
+// calls to 'solve()' under assumptions is checked against the pairwise encoding:
+static void randomized(uint64_t seed)
+{
+    const int  n_groups = 8, group_size = 5, vars = n_groups * group_size + 10;
+    TestRandom rnd(seed);
+    Solver     S;
+    AtMostOne  amo(vars);
+    S.verbosity = 0;
+    while (S.nVars() < vars) S.newVar();
+    S.connectPropagator(&amo);
+
+    vec<vec<Lit> > clauses, encoded;   // The clauses given to 'S', and the same with the pairwise encoding.
+    vec<Lit>       ps;
+    for (int i = 0; i < n_groups; i++){
+        ps.clear();
+        for (int k = 0; k < group_size; k++){
+            ps.push(mkLit(i * group_size + k));
+            S.addObservedVar(var(ps.last())); }
+        amo.addGroup(ps);
+        clauses.push();
+        ps.copyTo(clauses.last());
+        for (int j = 0; j < ps.size(); j++)
+            for (int k = j+1; k < ps.size(); k++){
+                encoded.push();
+                encoded.last().push(~ps[j]);
+                encoded.last().push(~ps[k]); }
+    }
+    for (int i = 0; i < 90; i++){
+        randomClause(rnd, vars, 3, ps);
+        clauses.push();
+        ps.copyTo(clauses.last()); }
+    for (int i = 0; i < clauses.size(); i++){
+        S.addClause(clauses[i]);
+        encoded.push();
+        clauses[i].copyTo(encoded.last()); }
+
+    vec<Lit> assumps;
+    for (int step = 0; step < 20 && S.okay(); step++){
+        assumps.clear();
+        for (int k = rnd.range(4); k > 0; k--)
+            assumps.push(rnd.lit(vars));
+        bool expect = freshSolve(vars, encoded, assumps);
+        bool result = S.solve(assumps);
+        CHECK(result == expect);
+        if (result)
+            CHECK(modelSatisfies(S, encoded, assumps));
+        else if (S.okay())
+            CHECK(conflictValid(S, vars, encoded, assumps));
+        else
+            CHECK(!freshSolve(vars, encoded, vec<Lit>()));
+    }
+    reasons    += amo.reasons;
+    conflicts  += amo.conflicts;
+    backtracks += amo.backtracks;
+}
+
+
+int main()
+{
+    for (uint64_t seed = 1; seed <= 100; seed++)
+        randomized(seed);
+    printf("propagator: %d lazy reasons, %d conflicts above the root, %d backtracks\n", reasons, conflicts, backtracks);
+    CHECK(reasons > 0 && conflicts > 0 && backtracks > 0);
+    printf("propagator: OK\n");
+    return 0;
+}
@@ -0,0 +1,120 @@
+/***********************************************************************************[trail_reuse.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "UnitTest.h"
+#include "minisat/simp/SimpSolver.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Trail reuse: repeated calls to 'solve()' with a shared assumption prefix and changing suffixes,
+// with clauses added and 'simplify()' called in between (all of which backtrack the kept levels).
+
+
+static void freeze(Solver&,     Var)   { }
+static void freeze(SimpSolver& S, Var v) { S.setFrozen(v, true); }
+
+
+// The assumptions are over the first 'assumable' variables (frozen in 'SimpSolver', which may
+// eliminate or substitute the others). Returns how many calls kept levels of the previous one.
+template<class S_t>
+static int sequence(uint64_t seed)
+{
+    const int  vars = 40, assumable = 10;
+    TestRandom rnd(seed);
+    S_t        S;
+    S.verbosity = 0;
+    while (S.nVars() < vars) S.newVar();
+    for (Var v = 0; v < assumable; v++)
+        freeze(S, v);
+
+    // Random 3-SAT below the threshold, plus a few equivalences for 'SimpSolver' to substitute:
+    vec<vec<Lit> > clauses;
+    vec<Lit>       ps;
+    for (int i = 0; i < 120; i++){
+        randomClause(rnd, vars, 3, ps);
+        clauses.push();
+        ps.copyTo(clauses.last()); }
+    for (int i = 0; i < 3; i++){
+        Lit x = mkLit(assumable + rnd.range(vars - assumable), rnd.next() & 1);
+        Lit y = mkLit(assumable + rnd.range(vars - assumable));
+        if (var(x) == var(y)) continue;
+        clauses.push(); clauses.last().push(~x); clauses.last().push(y);
+        clauses.push(); clauses.last().push(x);  clauses.last().push(~y); }
+    for (int i = 0; i < clauses.size(); i++)
+        S.addClause(clauses[i]);
+
+    vec<Lit> prefix, assumps;
+    for (int i = 0; i < 4; i++)
+        prefix.push(rnd.lit(assumable));
+
+    int      reusing = 0;
+    uint64_t last    = S.reused_levels;
+    for (int step = 0; step < 80; step++){
+        int op = rnd.range(16);
+        if (op == 0){
+            randomClause(rnd, assumable, 3, ps);
+            S.addClause(ps);
+            clauses.push();
+            ps.copyTo(clauses.last());
+        }else if (op == 1)
+            S.simplify();
+        else if (op == 2)
+            prefix[rnd.range(prefix.size())] = rnd.lit(assumable);
+
+        // The whole prefix, or most of the time a part of it, then a new suffix:
+        assumps.clear();
+        int shared = rnd.range(4) == 0 ? rnd.range(prefix.size()) : prefix.size();
+        for (int i = 0; i < shared; i++)
+            assumps.push(prefix[i]);
+        for (int k = rnd.range(3); k > 0; k--)
+            assumps.push(rnd.lit(assumable));
+
+        bool expect = freshSolve(vars, clauses, assumps);
+        bool result = S.solve(assumps);
+        CHECK(result == expect);
+        if (!S.okay()){
+            // (Contradictory for good, which only the added clauses can do.)
+            CHECK(!freshSolve(vars, clauses, vec<Lit>()));
+            break; }
+        if (result)
+            CHECK(modelSatisfies(S, clauses, assumps));
+        else
+            CHECK(conflictValid(S, vars, clauses, assumps));
+
+        CHECK(S.reused_levels >= last);
+        if (S.reused_levels > last) reusing++;
+        last = S.reused_levels;
+    }
+    return reusing;
+}
+
+
+int main()
+{
+    int reusing = 0;
+    for (uint64_t seed = 1; seed <= 100; seed++)
+        reusing += sequence<Solver>(seed);
+    printf("trail_reuse: %d calls kept levels\n", reusing);
+    CHECK(reusing > 1000);
+
+    // ('SimpSolver' backtracks to the root to simplify, so it is only checked for correctness.)
+    for (uint64_t seed = 1; seed <= 50; seed++)
+        sequence<SimpSolver>(seed);
+    printf("trail_reuse: OK\n");
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <cmath>
+
+#include "Sudoku_Utils.h"
+#include "Sudoku_Solver_minisat_v1.h"
+#include "Sudoku_Solver_Backtrack_v1.h"
+
+/*
+In-process benchmark of the 9x9 Sudoku solvers. Replaces benchmark.py, which started the solver binary once per run
+and mostly measured process startup.
+
+Every puzzle of every collection is solved by each solver 'warmup' times without measuring and then 'runs' times with
+measuring. The time of a run covers all the work for one puzzle: building the solver, applying the clues, solving and
+extracting the solution. The per puzzle mean, median, p99 and standard deviation (in milliseconds) are written to
+table.md and results.csv in the output directory, and a summary per collection is printed on the console.
+
+Usage: sudoku_benchmark [--warmup N] [--runs N] [--max-puzzles N] [--out DIR] [collection files or directories...]
+By default the collections are sudoku/inputs/benchmark/top95.txt and all files in data/Sudoku/puzzles_3x3, except the
+ones with invalid puzzles (bad_*, collections_bad). A collection file has one puzzle of 81 characters per line, with
+'.' or '0' for empty cells.
+*/
+
+namespace mm {
+
+	namespace {
+
+		struct SudokuCollection
+		{
+			string m_name;
+			vector< vector<int> > m_puzzles;
+		};
+
+		struct SudokuTimingStats
+		{
+			double m_mean = 0;
+			double m_median = 0;
+			double m_p99 = 0;
+			double m_stdev = 0;
+		};
+
+		typedef bool(*SudokuBenchmarkSolver)(const vector<int>& puzzle, vector<int>& solution);
+
+		bool solveWith_SAT_v1(const vector<int>& puzzle, vector<int>& solution)
+		{
+			SudokuSolverSAT_v1 s(9);
+			if (!s.apply_board(puzzle) || !s.solve())
+				return false;
+			s.get_solution(solution);
+			return true;
+		}
+
+		bool solveWith_Matrix5(const vector<int>& puzzle, vector<int>& solution)
+		{
+			vector< vector<int> > data(9, vector<int>(9, 0));
+			for (int i = 0; i < 81; ++i)
+				data[i / 9][i % 9] = puzzle[i];
+
+			SudokuPuzzleBasicStats stats;
+			vector< vector< vector<int> > > solutionSets;
+			if (!SudokuMatrix5::solve(data, solutionSets, 1, stats) || solutionSets.empty())
+				return false;
+			for (int i = 0; i < 81; ++i)
+				solution[i] = solutionSets[0][i / 9][i % 9];
+			return true;
+		}
+
+		const struct
+		{
+			const char* m_name;
+			SudokuBenchmarkSolver m_solve;
+		} benchmarkSolvers[] = {
+			{ "SudokuSolverSAT_v1", solveWith_SAT_v1 },
+			{ "SudokuMatrix5",      solveWith_Matrix5 },
+		};
+
+		bool readCollection(const string& fileName, SudokuCollection& collection, size_t maxPuzzles)
+		{
+			ifstream file(fileName);
+			if (!file.is_open())
+				return false;
+
+			collection.m_name = std::filesystem::path(fileName).filename().string();
+			string line;
+			while (std::getline(file, line) && (maxPuzzles == 0 || collection.m_puzzles.size() < maxPuzzles))
+			{
+				while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+					line.pop_back();
+				if (line.length() != 81)
+					continue;
+
+				vector<int> puzzle(81, 0);
+				for (int i = 0; i < 81; ++i)
+					puzzle[i] = (line[i] >= '1' && line[i] <= '9') ? line[i] - '0' : 0;
+				collection.m_puzzles.push_back(std::move(puzzle));
+			}
+			return true;
+		}
+
+		// Collection files of a directory, skipping the ones with invalid puzzles
+		void listCollections(const string& directory, vector<string>& fileNames)
+		{
+			vector<string> found;
+			for (const auto& entry : std::filesystem::directory_iterator(directory))
+			{
+				const string name = entry.path().filename().string();
+				if (entry.is_regular_file() && name.compare(0, 4, "bad_") != 0 && name != "collections_bad")
+					found.push_back(entry.path().string());
+			}
+			std::sort(found.begin(), found.end());
+			fileNames.insert(fileNames.end(), found.begin(), found.end());
+		}
+
+		// Percentiles use the nearest rank of the sorted times
+		SudokuTimingStats computeTimingStats(vector<double>& times)
+		{
+			SudokuTimingStats result;
+			if (times.empty())
+				return result;
+
+			std::sort(times.begin(), times.end());
+			const size_t n = times.size();
+			double sum = 0;
+			for (double t : times)
+				sum += t;
+			result.m_mean = sum / n;
+			result.m_median = n % 2 == 1 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+			result.m_p99 = times[static_cast<size_t>(std::ceil(0.99 * n)) - 1];
+			double squares = 0;
+			for (double t : times)
+				squares += (t - result.m_mean) * (t - result.m_mean);
+			result.m_stdev = n > 1 ? std::sqrt(squares / (n - 1)) : 0;
+			return result;
+		}
+	}
+
+	void sudoku_benchmark(int argc, char** argv)
+	{
+		int warmup = 1;
+		int runs = 10;
+		size_t maxPuzzles = 0;
+		string outDirectory = ".";
+		vector<string> inputs;
+		for (int i = 1; i < argc; ++i)
+		{
+			const string arg = argv[i];
+			if (arg == "--warmup" && i + 1 < argc)
+				warmup = std::stoi(argv[++i]);
+			else if (arg == "--runs" && i + 1 < argc)
+				runs = std::max(1, std::stoi(argv[++i]));
+			else if (arg == "--max-puzzles" && i + 1 < argc)
+				maxPuzzles = std::stoul(argv[++i]);
+			else if (arg == "--out" && i + 1 < argc)
+				outDirectory = argv[++i];
+			else
+				inputs.push_back(arg);
+		}
+		if (inputs.empty())
+		{
+			inputs.push_back("sudoku/inputs/benchmark/top95.txt");
+			inputs.push_back("data/Sudoku/puzzles_3x3");
+		}
+
+		vector<string> fileNames;
+		for (const string& input : inputs)
+		{
+			if (std::filesystem::is_directory(input))
+				listCollections(input, fileNames);
+			else
+				fileNames.push_back(input);
+		}
+
+		vector<SudokuCollection> collections;
+		for (const string& fileName : fileNames)
+		{
+			SudokuCollection collection;
+			if (!readCollection(fileName, collection, maxPuzzles))
+				std::cout << "\nCould not open the collection " << fileName;
+			else if (!collection.m_puzzles.empty())
+				collections.push_back(std::move(collection));
+		}
+
+		ofstream tableFile(outDirectory + "/table.md");
+		ofstream csvFile(outDirectory + "/results.csv");
+		tableFile << "| Collection | Problem | Solver | Time taken mean (ms) | median (ms) | p99 (ms) | stdev (ms) |\n";
+		tableFile << "|------------|---------|--------|----------------------|-------------|----------|------------|\n";
+		csvFile << "collection, problem, solver, mean, median, p99, stdev\n";
+		tableFile << std::fixed << std::setprecision(4);
+		csvFile << std::fixed << std::setprecision(4);
+
+		std::cout << "\n" << std::left << std::setw(24) << "Collection" << std::setw(20) << "Solver"
+			<< std::right << std::setw(9) << "Puzzles" << std::setw(10) << "Failed"
+			<< std::setw(14) << "mean (ms)" << std::setw(14) << "median (ms)" << std::setw(14) << "p99 (ms)" << std::setw(14) << "max (ms)";
+		std::cout << std::fixed << std::setprecision(4);
+
+		vector<int> solution(81, 0);
+		for (const SudokuCollection& collection : collections)
+		{
+			for (const auto& solver : benchmarkSolvers)
+			{
+				vector<double> puzzleMeans;
+				int failed = 0;
+				for (size_t index = 0; index < collection.m_puzzles.size(); ++index)
+				{
+					const vector<int>& puzzle = collection.m_puzzles[index];
+					for (int i = 0; i < warmup; ++i)
+						solver.m_solve(puzzle, solution);
+
+					vector<double> times;
+					bool solved = true;
+					for (int i = 0; i < runs; ++i)
+					{
+						std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+						solved = solver.m_solve(puzzle, solution);
+						std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+						times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+					}
+					if (!solved || !Sudoku_Utils::validateSudokuSolution(solution))
+						++failed;
+
+					SudokuTimingStats stats = computeTimingStats(times);
+					puzzleMeans.push_back(stats.m_mean);
+					tableFile << "| " << collection.m_name << " | " << index << " | " << solver.m_name << " | " << stats.m_mean << " | "
+						<< stats.m_median << " | " << stats.m_p99 << " | " << stats.m_stdev << " |\n";
+					csvFile << collection.m_name << ", " << index << ", " << solver.m_name << ", " << stats.m_mean << ", "
+						<< stats.m_median << ", " << stats.m_p99 << ", " << stats.m_stdev << "\n";
+				}
+
+				// Summary over the mean times of the puzzles of the collection (sorts 'puzzleMeans', so the last one is the maximum)
+				SudokuTimingStats summary = computeTimingStats(puzzleMeans);
+				std::cout << "\n" << std::left << std::setw(24) << collection.m_name << std::setw(20) << solver.m_name
+					<< std::right << std::setw(9) << collection.m_puzzles.size() << std::setw(10) << failed
+					<< std::setw(14) << summary.m_mean << std::setw(14) << summary.m_median << std::setw(14) << summary.m_p99
+					<< std::setw(14) << puzzleMeans.back();
+			}
+		}
+		std::cout << "\n\nResults written to " << outDirectory << "/table.md and " << outDirectory << "/results.csv\n";
+	}
+
+}
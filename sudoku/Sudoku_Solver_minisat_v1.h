@@ -19,6 +19,7 @@ public:
     // Returns true if the sudoku has a solution
     bool solve();
 	void get_solution(std::vector<int>& solution) const;
+	const Minisat::Solver& get_solver() const { return solver; }
 
 private:
     void one_square_one_value();
@@ -33,5 +34,3 @@ private:
 	const int columns_;
 	const int values_;
 };
-
-bool test_SudokuSolverSAT_v1(int dimension, const std::vector<int>& sudokuPuzzle, std::vector<int>& sudokuSolution, std::chrono::high_resolution_clock::time_point tps[]);
@@ -3,13 +3,22 @@
 import plotly
 from plotly.graph_objs import Layout as Layout, Box as BoxPlot
 from math import ceil
+import csv
+import sys
 
 
-with open('gcc-results-classic.txt', 'r') as classic_file:
-    classic_results = sorted([float(line.split(',')[1]) for line in classic_file])
+# results.csv has one row per collection and solver; only SudokuSolverSAT_v1 is plotted, over all
+# collections or the one given on the command line
+collection = sys.argv[1] if len(sys.argv) > 1 else None
 
-with open('gcc-results-lto.txt', 'r') as lto_file:
-    lto_results = sorted([float(line.split(',')[1]) for line in lto_file])
+def read_means(file_name):
+    with open(file_name, 'r', newline='') as results_file:
+        rows = csv.DictReader(results_file, skipinitialspace=True) # the header has a space after every comma
+        return sorted([float(row['mean']) for row in rows
+                       if row['solver'] == 'SudokuSolverSAT_v1' and collection in (None, row['collection'])])
+
+classic_results = read_means('gcc-results-classic.txt')
+lto_results = read_means('gcc-results-lto.txt')
 
 
 def percentile_bound(data, p):
@@ -0,0 +1,36 @@
+#!/usr/bin/env python3
+
+import plotly
+from plotly.graph_objs import Layout as Layout, Scatter as Scatter
+from collections import defaultdict
+from statistics import mean
+
+
+# sudoku_scaling.csv is written by sudoku_test() in sudoku_main.cpp
+with open('sudoku_scaling.csv', 'r') as scaling_file:
+    header = [name.strip() for name in next(scaling_file).split(',')]
+    rows = [dict(zip(header, [value.strip() for value in line.split(',')])) for line in scaling_file]
+
+steps = ['initialization_ns', 'applyBoard_ns', 'solving_ns', 'extractSolution_ns']
+grids = []
+times = defaultdict(list)
+for row in rows:
+    if row['grid'] not in grids:
+        grids.append(row['grid'])
+    for step in steps:
+        times[(row['grid'], step)].append(float(row[step]) / 1e6)
+
+
+data = [
+        Scatter(x = grids, y = [mean(times[(grid, step)]) for grid in grids], name = step[:-3])
+        for step in steps
+    ]
+
+
+plotly.offline.plot({
+    'layout': Layout(title = 'SAT-based Sudoku solver scaling',
+                     xaxis = {'title':'Grid'},
+                     yaxis = {'title':'Time [ms]', 'type':'log'},
+                     ),
+    'data': data
+})
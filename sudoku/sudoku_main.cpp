@@ -1,8 +1,11 @@
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <chrono>
 
+#include <minisat/utils/System.h>
+
 #include "Sudoku_Generator.h"
 #include "Sudoku_Utils.h"
 
@@ -11,11 +14,30 @@
 
 namespace mm
 {
+	/*
+	Scaling benchmark of SudokuSolverSAT_v1 over the Sudoku dimensions (grids of 4x4 up to 64x64). Runs without any
+	interaction: for every dimension a few puzzles are generated and solved, and one row per puzzle is written to
+	sudoku_scaling.csv with the size of the SAT problem (variables, clauses, bytes of the clause arena before and after
+	solving), the memory of the process (current and peak, in MB) and the time of each step (in nanoseconds). The pairwise encoding of the
+	"exactly one" constraints needs O(n^4) clauses for n x n grids, so larger dimensions quickly need gigabytes.
+	When minisat is built with MINISAT_PROFILE, the time of solving is also broken up by phase of the solver (one column per
+	phase, empty otherwise).
+	*/
 	void sudoku_test()
 	{
-		int dimensionStart = 2;
-		int dimensionEnd = 10;
-		int numPuzzles = 1;
+		const int dimensionStart = 2;
+		const int dimensionEnd = 8;
+		const int numPuzzles = 3;
+		const string csvFileName = "sudoku_scaling.csv";
+
+		ofstream csvFile(csvFileName);
+		csvFile << "dimension, grid, puzzle, clues, variables, clauses, arena_bytes, arena_bytes_final, mem_used_mb, mem_peak_mb, "
+			"generation_ns, initialization_ns, applyBoard_ns, solving_ns, ";
+		for (int phase = 0; phase < Minisat::phase_Count; ++phase)
+			csvFile << Minisat::phaseName(phase) << "_ns, ";
+		csvFile << "extractSolution_ns, total_ns, result\n";
+
+		srand(1); // The puzzles are generated with rand(); keep them the same from run to run
 		for (int dimension = dimensionStart; dimension <= dimensionEnd; ++dimension)
 		{
 			for (int puzzleIndex = 0; puzzleIndex < numPuzzles; ++puzzleIndex)
@@ -25,46 +47,81 @@ namespace mm
 				int iterations = 0;
 				unsigned long long timeRequiredToGeneratePuzzle = 0;
 				SudokuPuzzleGenerator::generateSudokuPuzzle(sudokuDimension, sudokuPuzzle, iterations, timeRequiredToGeneratePuzzle);
-				Sudoku_Utils::printSudokuGrid(sudokuPuzzle);
+				int clues = 0;
+				for (int value : sudokuPuzzle)
+					clues += value != 0 ? 1 : 0;
 
 				vector<int> sudokuSolution(sudokuDimension * sudokuDimension, 0);
-
-				std::chrono::high_resolution_clock::time_point tps[5];
-				std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
-				bool result = test_SudokuSolverSAT_v1(sudokuDimension, sudokuPuzzle, sudokuSolution, tps);
-				std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
-				//unsigned long long duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-				//typedef ratio<1, 1000000000> nano;
-				std::chrono::duration<unsigned long long, std::nano> time_taken = end - start;
-				unsigned long long duration = time_taken.count();
-				unsigned long long initialization  = std::chrono::duration_cast<std::chrono::nanoseconds>(tps[1] - tps[0]).count();
-				unsigned long long applyBoard      = std::chrono::duration_cast<std::chrono::nanoseconds>(tps[2] - tps[1]).count();
+				unsigned long long initialization = 0;
+				unsigned long long applyBoard = 0;
 				unsigned long long solving = 0;
 				unsigned long long extractSolution = 0;
-				if (result)
+				int variables = 0;
+				int clauses = 0;
+				unsigned long long arenaBytes = 0;
+				unsigned long long arenaBytesFinal = 0;
+				double memoryUsed = 0;
+				vector<unsigned long long> phaseTimes(Minisat::phase_Count, 0);
+				string result;
+				try
 				{
-					solving = std::chrono::duration_cast<std::chrono::nanoseconds>(tps[3] - tps[2]).count();
+					std::chrono::steady_clock::time_point tps[5];
+					tps[0] = std::chrono::steady_clock::now();
+					SudokuSolverSAT_v1 s(sudokuDimension);
+					tps[1] = std::chrono::steady_clock::now();
+					variables = s.get_solver().nVars();
+					clauses = s.get_solver().nClauses();
+					arenaBytes = s.get_solver().nArenaBytes();
+
+					bool applied = s.apply_board(sudokuPuzzle);
+					tps[2] = tps[3] = tps[4] = std::chrono::steady_clock::now();
+					if (!applied)
+						result = "CONTRADICTION";
+					else if (!s.solve())
+					{
+						tps[3] = tps[4] = std::chrono::steady_clock::now();
+						result = "UNSAT";
+					}
+					else
+					{
+						tps[3] = std::chrono::steady_clock::now();
+						s.get_solution(sudokuSolution);
+						tps[4] = std::chrono::steady_clock::now();
+						result = Sudoku_Utils::validateSudokuSolution(sudokuSolution) ? "SUCCESS" : "FAILED";
+					}
+					arenaBytesFinal = s.get_solver().nArenaBytes(); // After solving (learnt clauses, garbage collection)
+					memoryUsed = Minisat::memUsed();
+					for (int phase = 0; phase < Minisat::phase_Count; ++phase)
+						phaseTimes[phase] = static_cast<unsigned long long>(s.get_solver().profile.seconds(phase) * 1e9);
+
+					initialization  = std::chrono::duration_cast<std::chrono::nanoseconds>(tps[1] - tps[0]).count();
+					applyBoard      = std::chrono::duration_cast<std::chrono::nanoseconds>(tps[2] - tps[1]).count();
+					solving         = std::chrono::duration_cast<std::chrono::nanoseconds>(tps[3] - tps[2]).count();
 					extractSolution = std::chrono::duration_cast<std::chrono::nanoseconds>(tps[4] - tps[3]).count();
 				}
+				catch (Minisat::OutOfMemoryException&)
+				{
+					result = "OUT_OF_MEMORY";
+				}
+				unsigned long long total = initialization + applyBoard + solving + extractSolution;
+
+				csvFile << dimension << ", " << sudokuDimension << "x" << sudokuDimension << ", " << puzzleIndex << ", " << clues << ", "
+					<< variables << ", " << clauses << ", " << arenaBytes << ", " << arenaBytesFinal << ", " << memoryUsed << ", " << Minisat::memUsedPeak() << ", "
+					<< timeRequiredToGeneratePuzzle << ", " << initialization << ", " << applyBoard << ", " << solving << ", ";
+				for (int phase = 0; phase < Minisat::phase_Count; ++phase)
+				{
+					if (Minisat::ProfilingPolicy::enabled)
+						csvFile << phaseTimes[phase];
+					csvFile << ", ";
+				}
+				csvFile << extractSolution << ", " << total << ", " << result << std::endl;
 
-				Sudoku_Utils::printSudokuGrid(sudokuSolution, sudokuPuzzle);
-				std::cout << "\n";
-				std::cout << "\nSudoku dimention: " << sudokuDimension << "x" << sudokuDimension;
-				std::cout << "\nResult: " << (result ? "True" : "False");
-				std::cout << "\nSolution found in " << formatWithCommas(duration) << " nanoseconds";
-				std::cout << "\nTime duration break-up:";
-				std::cout << "\n    Initialization  : " << formatWithCommas(initialization) << " nanoseconds";
-				std::cout << "\n    applyBoard      : " << formatWithCommas(applyBoard) << " nanoseconds";
-				std::cout << "\n    solving         : " << formatWithCommas(solving) << " nanoseconds";
-				std::cout << "\n    extractSolution : " << formatWithCommas(extractSolution) << " nanoseconds";
-				std::cout << "\n    Total           : " << formatWithCommas(initialization + applyBoard + solving + extractSolution) << " nanoseconds";
-				bool success = Sudoku_Utils::validateSudokuSolution(sudokuSolution);
-				std::cout << "\nSolution validation: " << (success ? "SUCCESS" : "FAILED");
-				std::cout << "\n";
-				std::cout << "\nPress any key to continue...";
-				std::cin.get();
+				std::cout << "\nSudoku dimention: " << sudokuDimension << "x" << sudokuDimension << " puzzle " << puzzleIndex
+					<< ": " << result << " in " << formatWithCommas(total) << " nanoseconds ("
+					<< formatWithCommas(clauses) << " clauses, " << formatWithCommas(arenaBytes) << " arena bytes)";
 			}
 		}
+		std::cout << "\n\nResults written to " << csvFileName << "\n";
 	}
 
 }